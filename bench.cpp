@@ -0,0 +1,1139 @@
+// pruning of blanks from an ascii stream -- benchmark of all pruners built for the host
+//
+// build: g++ -O3 bench.cpp -o bench -pthread
+// usage: bench [-n chars] [-p passes] [-r reps] [-w warmups] [-c MHz] [-t threads] [-L] [-T] [-P]
+//              [-F feed] [-i pattern|density|json|csv|log|source|mixed] [-d blank%] [-l blank-run] [-f file] [-S]
+//              [-x chase|copy] [-k KB] [-M collapse|map|fields|adapt|json] [pruner ...]
+//
+// Every pruner supported by the cpu (or just the ones named) bulk-prunes a buffer of -n chars, -p times per rep;
+// after -w warm-up reps, -r timed reps are taken, and their min and median are reported. Cycles and instructions
+// come from perf_event_open when available (see perf_event_paranoid); otherwise clocks derive from wall time at the
+// clock given by -c, as in lattest.sh, or only wall-clock figures are given.
+//
+// The input is by default the 32 chars of the timing loop of prune.cpp, over and over, in an L1-resident buffer; -i
+// picks a synthetic corpus instead, 1MB by default: text of -d percent blanks in runs of -l mean length, or samples
+// of pretty-printed json, padded csv, service logs or c-like source, or 64KB stretches of text of densities from none
+// to all blanks; -f tiles a file over the buffer. -S sweeps the
+// blank density from 0% to 100%, reporting median clocks/char (chars/ns without a clock) per pruner and density.
+//
+// -t prunes by prune_parallel across the given count of threads, or by prune_lookback with -L; -T sweeps the thread
+// count in powers of two up to -t, or the count of online cpus, over a 256MB buffer by default, reporting the
+// aggregate throughput of both per pruner and thread count -- where it stops scaling, memory bandwidth has run out.
+// Clocks/char are not reported in that mode.
+//
+// -P prunes in place rather than from the input buffer to a separate output one; as that consumes the input, it is
+// restored before every pass, outside the timed span, so figures compare to the out-of-place ones for all but a
+// small buffer, where the per-pass reading of the counters shows. In-place multi-threaded pruning is look-back only.
+//
+// -F feeds each pass to a stream -- see prune_stream.h -- in chunks of the given count of chars, as network reads
+// would come, so the figures compare to those of one bulk call over the buffer.
+//
+// -x co-runs a competing workload of a -k KB working set, 32KB by default, interleaved with the pruning: after every
+// 4KB of input pruned, the co-runner sweeps its working set once, either chasing pointers through it, a cache line
+// at a time in random order, or copying its one half over the other by memcpy. Both sides are timed slice by slice,
+// by wall clock, and the pruner's clocks/char and the co-runner's time per sweep are reported, next to the ones each
+// takes when run alone -- what a pruner's tables and code take from the cache shows in both. Clocks derive from -c,
+// else from the cycles over the wall time of the solo run, when perf counters are available.
+//
+// -M times one of the other operations built on the pruners, over the same input, next to the pruner it builds on,
+// checking each variant against its scalar one: collapse times the collapsing of blank runs of prune_collapse.h, and
+// map the pruning with a map back to the source of prune_map.h, checking each offset against the char it maps, and
+// fields the pruning of the input as fields of 8 - 40 chars by prune_fields.h, checking each field on its own. adapt
+// times the adaptive pruner of prune_adapt.h next to each of its candidates, over the mixed corpus unless -i or -f
+// say otherwise, and counts the chunks each candidate pruned, and the switches, over a pass. json times the minifiers
+// of prune_json.h, and json_minify(), next to testee04 and testee07, over the json corpus unless -i or -f say
+// otherwise, checking each against the scalar minifier.
+#include "prune.h"
+#include "prune_mt.h"
+#include "prune_stream.h"
+#include "prune_collapse.h"
+#include "prune_map.h"
+#include "prune_fields.h"
+#include "prune_adapt.h"
+#include "prune_json.h"
+#include "perfcnt.h"
+#include "corpus.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+struct sample {
+	double cpc; // clocks per char
+	double ipc; // instructions per clock
+	double cpn; // chars per ns
+	double mhz; // cycles per us
+};
+
+static int cmp_double(void const* a, void const* b) {
+	double const x = *reinterpret_cast< double const* >(a);
+	double const y = *reinterpret_cast< double const* >(b);
+	return x < y ? -1 : x > y ? 1 : 0;
+}
+
+// median of n values, n > 0; sorts the values in the process
+static double median(double* const val, size_t const n) {
+	qsort(val, n, sizeof(val[0]), cmp_double);
+	return n & 1 ? val[n / 2] : (val[n / 2 - 1] + val[n / 2]) * .5;
+}
+
+struct result {
+	double cpc_min;
+	double cpc_med;
+	double ipc_med;
+	double cpn_med;
+	double mhz_med; // cycles over wall time; zero without perf counters
+};
+
+enum {
+	corun_chunk = 1 << 12, // input chars pruned between sweeps of the co-runner
+	corun_line = 64        // co-runner working set granularity
+};
+
+// competing workload for co-runs
+struct corunner {
+	bool chase;    // chase pointers, or copy
+	size_t size;   // working set, in bytes
+	uint8_t* buf;  // chase: cache lines, each holding the offset of the next at its start; copy: source, destination
+	size_t cursor; // chase: offset of the line to resume at
+};
+
+// prepare a co-runner of the given kind and working set; false on unknown kind or no memory
+static bool corun_init(
+	corunner& co,
+	char const* const kind,
+	size_t const size) {
+
+	co.chase = 0 == strcmp(kind, "chase");
+	if (!co.chase && strcmp(kind, "copy"))
+		return false;
+
+	co.size = size < size_t(corun_line) * 2 ? size_t(corun_line) * 2 : size & ~size_t(corun_line - 1);
+	co.buf = reinterpret_cast< uint8_t* >(aligned_alloc(corun_line, co.size));
+	co.cursor = 0;
+	if (0 == co.buf)
+		return false;
+
+	memset(co.buf, 1, co.size);
+	if (!co.chase)
+		return true;
+
+	// a single random cycle through all lines, by Sattolo's shuffle, so no prefetcher can follow
+	size_t const lines = co.size / corun_line;
+	size_t* const order = reinterpret_cast< size_t* >(malloc(sizeof(size_t) * lines));
+	if (0 == order)
+		return false;
+
+	for (size_t i = 0; i < lines; ++i)
+		order[i] = i;
+
+	srand(42);
+	for (size_t i = lines - 1; i > 0; --i) {
+		size_t const j = size_t(rand()) % i;
+		size_t const t = order[i];
+		order[i] = order[j];
+		order[j] = t;
+	}
+
+	for (size_t i = 0; i < lines; ++i)
+		*reinterpret_cast< size_t* >(co.buf + order[i] * corun_line) = order[(i + 1) % lines] * corun_line;
+
+	free(order);
+	return true;
+}
+
+// touch the whole working set once
+static void corun_sweep(corunner& co) {
+	if (co.chase) {
+		size_t p = co.cursor;
+		for (size_t i = 0; i < co.size / corun_line; ++i)
+			p = *reinterpret_cast< size_t const* >(co.buf + p);
+
+		// the chase has no other consumer
+		asm volatile ("" : : "r"(p));
+		co.cursor = p;
+	}
+	else
+		memcpy(co.buf + co.size / 2, co.buf, co.size / 2);
+
+	asm volatile ("" : : : "memory");
+}
+
+struct corun_result {
+	double cpc_med;       // pruner clocks per char, co-run
+	double cpn_med;       // pruner chars per ns, co-run
+	double sweep_solo_ns; // co-runner median ns per sweep, alone
+	double sweep_ns;      // co-runner median ns per sweep, co-run
+};
+
+struct bench_conf {
+	size_t passes;
+	size_t reps;
+	size_t warmups;
+	size_t threads;
+	bool lookback;   // single-pass multi-threaded pruning
+	bool inplace;
+	size_t feed;     // chars per stream feed; 0 for bulk calls
+	double mhz;
+	perfcnt_group group;
+	bool has_perf;
+	sample* samples; // reps-sized scratch
+	double* val;     // ditto
+};
+
+// bulk-prune by the scheme of the conf
+static size_t run(
+	bench_conf const& conf,
+	pruner const& pr,
+	uint8_t const* const in,
+	size_t const nchars,
+	uint8_t* const out) {
+
+	if (conf.feed) {
+		// a pruner too wide for the stream gets a count no output matches, and reports as a mismatch
+		prune_stream st;
+		if (!prune_stream_init(st, &pr))
+			return size_t(-1);
+
+		size_t pos = 0;
+		for (size_t i = 0; i < nchars; i += conf.feed)
+			pos += prune_stream_feed(st, in + i, nchars - i < conf.feed ? nchars - i : conf.feed, out + pos);
+
+		return pos + prune_stream_finish(st, out + pos);
+	}
+
+	if (conf.threads < 2)
+		return pr.prune(in, nchars, out, nchars);
+
+	return conf.lookback || conf.inplace
+		? prune_lookback(in, nchars, out, conf.threads, &pr)
+		: prune_parallel(in, nchars, out, conf.threads, &pr);
+}
+
+// bulk operation of in to out, by whatever arg carries; returns the count of chars in out
+typedef size_t (*bench_op)(void const* arg, uint8_t const* in, size_t len, uint8_t* out);
+
+// time op over in, by the scheme of the conf
+static void measure_op(
+	bench_conf& conf,
+	bench_op const op,
+	void const* const arg,
+	uint8_t const* const in,
+	size_t const nchars,
+	uint8_t* const out,
+	result& res) {
+
+	// in-place pruning consumes its input, so each pass gets a fresh copy, outside the timed span
+	uint8_t const* const src = conf.inplace ? out : in;
+	size_t const spans = conf.inplace ? conf.passes : 1;
+	size_t const span_passes = conf.inplace ? 1 : conf.passes;
+
+	for (size_t r = 0; r < conf.warmups + conf.reps; ++r) {
+		uint64_t ns = 0;
+		uint64_t value[PERFCNT_COUNT] = { 0 };
+
+		for (size_t k = 0; k < spans; ++k) {
+			if (conf.inplace)
+				memcpy(out, in, nchars);
+
+			uint64_t const t0 = perfcnt_ns();
+			perfcnt_start(conf.group);
+
+			for (size_t p = 0; p < span_passes; ++p) {
+				op(arg, src, nchars, out);
+
+				// iteration obfuscator
+				asm volatile ("" : : : "memory");
+			}
+
+			perfcnt_stop(conf.group);
+			uint64_t const t1 = perfcnt_ns();
+
+			uint64_t span_value[PERFCNT_COUNT];
+			perfcnt_read(conf.group, span_value);
+
+			ns += t1 - t0;
+			for (size_t i = 0; i < PERFCNT_COUNT; ++i)
+				value[i] += span_value[i];
+		}
+
+		if (r < conf.warmups)
+			continue;
+
+		double const chars = double(nchars) * double(conf.passes);
+		sample& s = conf.samples[r - conf.warmups];
+		s.cpc = conf.has_perf ? double(value[PERFCNT_CYCLES]) / chars : double(ns) * conf.mhz * 1e-3 / chars;
+		s.ipc = value[PERFCNT_CYCLES] ? double(value[PERFCNT_INSTRUCTIONS]) / double(value[PERFCNT_CYCLES]) : 0.0;
+		s.cpn = chars / double(ns ? ns : 1);
+		s.mhz = double(value[PERFCNT_CYCLES]) * 1e3 / double(ns ? ns : 1);
+	}
+
+	for (size_t r = 0; r < conf.reps; ++r)
+		conf.val[r] = conf.samples[r].cpc;
+	res.cpc_med = median(conf.val, conf.reps);
+	res.cpc_min = conf.val[0];
+
+	for (size_t r = 0; r < conf.reps; ++r)
+		conf.val[r] = conf.samples[r].ipc;
+	res.ipc_med = median(conf.val, conf.reps);
+
+	for (size_t r = 0; r < conf.reps; ++r)
+		conf.val[r] = conf.samples[r].cpn;
+	res.cpn_med = median(conf.val, conf.reps);
+
+	for (size_t r = 0; r < conf.reps; ++r)
+		conf.val[r] = conf.samples[r].mhz;
+	res.mhz_med = median(conf.val, conf.reps);
+}
+
+struct run_arg {
+	bench_conf const* conf;
+	pruner const* pr;
+};
+
+static size_t run_op(
+	void const* const arg,
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out) {
+
+	run_arg const& a = *reinterpret_cast< run_arg const* >(arg);
+	return run(*a.conf, *a.pr, in, len, out);
+}
+
+// time the bulk pruning of in by pr; false if the output does not match testee00
+static bool measure(
+	bench_conf& conf,
+	pruner const& pr,
+	uint8_t const* const in,
+	size_t const nchars,
+	uint8_t* const out,
+	uint8_t* const ref,
+	result& res) {
+
+	// sanity: the same output as the scalar pruner
+	size_t const ref_len = prune_testee00(in, nchars, ref, nchars);
+	if (conf.inplace)
+		memcpy(out, in, nchars);
+	if (run(conf, pr, conf.inplace ? out : in, nchars, out) != ref_len || memcmp(out, ref, ref_len))
+		return false;
+
+	run_arg const arg = { &conf, &pr };
+	measure_op(conf, run_op, &arg, in, nchars, out, res);
+	return true;
+}
+
+// report a row of the figures of an op, as the default mode does, but for the batch
+static void print_op(
+	bench_conf const& conf,
+	char const* const name,
+	result const& res) {
+
+	if (conf.has_perf)
+		printf("| %-10s | %15.4f | %18.4f | %10.2f | %15.4f | %12.2f |\n",
+			name, res.cpc_min, res.cpc_med, res.ipc_med, res.cpn_med, res.cpn_med * 1e9 / (1 << 30));
+	else if (0.0 != conf.mhz)
+		printf("| %-10s | %15.4f | %18.4f | %10s | %15.4f | %12.2f |\n",
+			name, res.cpc_min, res.cpc_med, "-", res.cpn_med, res.cpn_med * 1e9 / (1 << 30));
+	else
+		printf("| %-10s | %15s | %18s | %10s | %15.4f | %12.2f |\n",
+			name, "-", "-", "-", res.cpn_med, res.cpn_med * 1e9 / (1 << 30));
+	fflush(stdout);
+}
+
+static void print_op_header() {
+	printf("| op         | clocks/char min | clocks/char median | IPC median | chars/ns median | GiB/s median |\n");
+	printf("| ---------- | --------------- | ------------------ | ---------- | --------------- | ------------ |\n");
+}
+
+// time the pruning of in by the named pruner, as a baseline for the modes; false if not supported or mismatched
+static bool measure_base(
+	bench_conf& conf,
+	char const* const name,
+	uint8_t const* const in,
+	size_t const nchars,
+	uint8_t* const out,
+	uint8_t* const ref) {
+
+	pruner const* const pr = find_pruner(name);
+	result res;
+
+	if (0 == pr || !pr->supported())
+		return false;
+	if (!measure(conf, *pr, in, nchars, out, ref, res)) {
+		printf("| %-10s | mismatch against testee00 |\n", name);
+		return false;
+	}
+
+	print_op(conf, name, res);
+	return true;
+}
+
+static size_t collapse_op(
+	void const* const arg,
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out) {
+
+	collapse_state st = collapse_init(false);
+	return (*reinterpret_cast< collapse_fn const* >(arg))(in, len, out, st);
+}
+
+// -M collapse: collapsing of blank runs by testee04's network, against testee04's pruning, checked against the scalar
+// collapser
+static void bench_collapse(
+	bench_conf& conf,
+	uint8_t const* const in,
+	size_t const nchars,
+	uint8_t* const out,
+	uint8_t* const ref) {
+
+	struct { char const* name; collapse_fn fn; bool supported; } const ops[] = {
+		{ "collapse00", collapse_testee00, true },
+#if __aarch64__
+		{ "collapse04", collapse_testee04, true },
+#elif __x86_64__ || __i386__
+		{ "collapse04", collapse_testee04, cpu_has_ssse3_popcnt() },
+#endif
+	};
+
+	measure_base(conf, "testee04", in, nchars, out, ref);
+
+	collapse_fn const scalar = collapse_testee00;
+	size_t const ref_len = collapse_op(&scalar, in, nchars, ref);
+
+	for (size_t k = 0; k < sizeof(ops) / sizeof(ops[0]); ++k) {
+		if (!ops[k].supported)
+			continue;
+
+		if (collapse_op(&ops[k].fn, in, nchars, out) != ref_len || memcmp(out, ref, ref_len)) {
+			printf("| %-10s | mismatch against collapse00 |\n", ops[k].name);
+			continue;
+		}
+
+		result res;
+		measure_op(conf, collapse_op, &ops[k].fn, in, nchars, out, res);
+		print_op(conf, ops[k].name, res);
+	}
+}
+
+// time the bulk pruning of in by pr, a chunk at a time, interleaved with sweeps of the co-runner, and the same count
+// of sweeps alone; clocks per char are at the given clock, if any
+static void measure_corun(
+	bench_conf& conf,
+	pruner const& pr,
+	uint8_t const* const in,
+	size_t const nchars,
+	uint8_t* const out,
+	corunner& co,
+	double const mhz,
+	corun_result& res) {
+
+	size_t const sweeps = (nchars + corun_chunk - 1) / corun_chunk * conf.passes;
+	double* const solo = reinterpret_cast< double* >(malloc(sizeof(double) * conf.reps * 2));
+	double* const cored = solo + conf.reps;
+
+	for (size_t r = 0; r < conf.warmups + conf.reps; ++r) {
+		uint64_t const t0 = perfcnt_ns();
+		for (size_t k = 0; k < sweeps; ++k)
+			corun_sweep(co);
+		uint64_t const t1 = perfcnt_ns();
+
+		uint64_t prune_ns = 0, sweep_ns = 0;
+		for (size_t p = 0; p < conf.passes; ++p)
+			for (size_t i = 0; i < nchars; i += corun_chunk) {
+				size_t const n = nchars - i < size_t(corun_chunk) ? nchars - i : size_t(corun_chunk);
+
+				uint64_t const s0 = perfcnt_ns();
+				pr.prune(in + i, n, out + i, n);
+				asm volatile ("" : : : "memory");
+				uint64_t const s1 = perfcnt_ns();
+				corun_sweep(co);
+				uint64_t const s2 = perfcnt_ns();
+
+				prune_ns += s1 - s0;
+				sweep_ns += s2 - s1;
+			}
+
+		if (r < conf.warmups)
+			continue;
+
+		double const chars = double(nchars) * double(conf.passes);
+		sample& s = conf.samples[r - conf.warmups];
+		s.cpc = double(prune_ns) * mhz * 1e-3 / chars;
+		s.cpn = chars / double(prune_ns ? prune_ns : 1);
+		solo[r - conf.warmups] = double(t1 - t0) / double(sweeps);
+		cored[r - conf.warmups] = double(sweep_ns) / double(sweeps);
+	}
+
+	for (size_t r = 0; r < conf.reps; ++r)
+		conf.val[r] = conf.samples[r].cpc;
+	res.cpc_med = median(conf.val, conf.reps);
+
+	for (size_t r = 0; r < conf.reps; ++r)
+		conf.val[r] = conf.samples[r].cpn;
+	res.cpn_med = median(conf.val, conf.reps);
+
+	res.sweep_solo_ns = median(solo, conf.reps);
+	res.sweep_ns = median(cored, conf.reps);
+	free(solo);
+}
+
+// prepare the input of the given kind; false on unknown kind or unreadable file
+static bool fill_input(
+	uint8_t* const in,
+	size_t const nchars,
+	char const* const kind,
+	char const* const file,
+	double const density,
+	double const run) {
+
+	if (file)
+		return corpus_file(in, nchars, file);
+
+	if (0 == strcmp(kind, "pattern")) {
+		// the input of the timing loop of prune.cpp, over and over
+		static char const pattern[] =
+			"012345 6789  abc"
+			"def 123456789abc";
+
+		for (size_t i = 0; i < nchars; ++i)
+			in[i] = pattern[i % (sizeof(pattern) - 1)];
+	}
+	else if (0 == strcmp(kind, "density"))
+		corpus_density(in, nchars, density, run);
+	else if (0 == strcmp(kind, "json"))
+		corpus_json(in, nchars);
+	else if (0 == strcmp(kind, "csv"))
+		corpus_csv(in, nchars);
+	else if (0 == strcmp(kind, "log"))
+		corpus_log(in, nchars);
+	else if (0 == strcmp(kind, "source"))
+		corpus_source(in, nchars);
+	else if (0 == strcmp(kind, "mixed"))
+		corpus_mixed(in, nchars);
+	else
+		return false;
+
+	return true;
+}
+
+// is the pruner among the ones named on the command line, if any
+static bool is_named(
+	pruner const& pr,
+	int const argc,
+	char** const argv) {
+
+	if (optind >= argc)
+		return true;
+
+	for (int i = optind; i < argc; ++i)
+		if (0 == strcmp(argv[i], pr.name))
+			return true;
+
+	return false;
+}
+
+struct map_arg {
+	prune_map_fn fn;
+	uint32_t* map;
+};
+
+static size_t map_op(
+	void const* const arg,
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out) {
+
+	map_arg const& a = *reinterpret_cast< map_arg const* >(arg);
+	return a.fn(in, len, out, a.map);
+}
+
+// -M map: pruning with a map back to the source, against testee04's pruning; the chars are checked against testee00,
+// and the map by the char each offset points at, and by its offsets rising
+static void bench_map(
+	bench_conf& conf,
+	uint8_t const* const in,
+	size_t const nchars,
+	uint8_t* const out,
+	uint8_t* const ref) {
+
+	struct { char const* name; prune_map_fn fn; bool supported; } const ops[] = {
+		{ "map00", prune_map00, true },
+#if __aarch64__
+		{ "map04", prune_map04, true },
+#elif __x86_64__ || __i386__
+		{ "map04", prune_map04, cpu_has_ssse3_popcnt() },
+#endif
+	};
+
+	uint32_t* const map = reinterpret_cast< uint32_t* >(malloc(sizeof(uint32_t) * nchars));
+	if (0 == map) {
+		fprintf(stderr, "error: out of memory\n");
+		return;
+	}
+
+	measure_base(conf, "testee04", in, nchars, out, ref);
+	size_t const ref_len = prune_testee00(in, nchars, ref, nchars);
+
+	for (size_t k = 0; k < sizeof(ops) / sizeof(ops[0]); ++k) {
+		if (!ops[k].supported)
+			continue;
+
+		map_arg const arg = { ops[k].fn, map };
+		bool match = map_op(&arg, in, nchars, out) == ref_len && 0 == memcmp(out, ref, ref_len);
+
+		for (size_t i = 0; i < ref_len && match; ++i)
+			match = map[i] < nchars && in[map[i]] == out[i] && (0 == i || map[i - 1] < map[i]);
+
+		if (!match) {
+			printf("| %-10s | mismatch against testee00 or the input |\n", ops[k].name);
+			continue;
+		}
+
+		result res;
+		measure_op(conf, map_op, &arg, in, nchars, out, res);
+		print_op(conf, ops[k].name, res);
+	}
+
+	free(map);
+}
+
+struct fields_arg {
+	prune_fields_fn fn;
+	uint32_t const* off;
+	size_t count;
+	uint32_t* out_off;
+};
+
+static size_t fields_op(
+	void const* const arg,
+	uint8_t const* const in,
+	size_t,
+	uint8_t* const out) {
+
+	fields_arg const& a = *reinterpret_cast< fields_arg const* >(arg);
+	return a.fn(in, a.off, a.count, out, a.out_off);
+}
+
+// the fields one call each, by prune(), as they would go without the batched api
+static size_t fields_each(
+	uint8_t const* const arena,
+	uint32_t const* const off,
+	size_t const count,
+	uint8_t* const out,
+	uint32_t* const out_off) {
+
+	out_off[0] = 0;
+	for (size_t k = 0; k < count; ++k)
+		out_off[k + 1] = out_off[k] + uint32_t(prune(arena + off[k], off[k + 1] - off[k], out + out_off[k]));
+
+	return out_off[count];
+}
+
+// -M fields: pruning of the input as short fields of 8 - 40 chars, batched and one call each, against testee04's
+// pruning of it as a whole; each field is checked against testee00's pruning of it alone
+static void bench_fields(
+	bench_conf& conf,
+	uint8_t const* const in,
+	size_t const nchars,
+	uint8_t* const out,
+	uint8_t* const ref) {
+
+	struct { char const* name; prune_fields_fn fn; bool supported; } const ops[] = {
+		{ "fields00", prune_fields00, true },
+#if __aarch64__
+		{ "fields04", prune_fields04, true },
+#elif __x86_64__ || __i386__
+		{ "fields04", prune_fields04, cpu_has_ssse3_popcnt() },
+#endif
+		{ "each", fields_each, true },
+	};
+
+	if (nchars >> 32) {
+		fprintf(stderr, "error: fields take an arena below 4GB\n");
+		return;
+	}
+
+	uint32_t* const off = reinterpret_cast< uint32_t* >(malloc(sizeof(uint32_t) * (nchars / 8 + 2)));
+	uint32_t* const out_off = reinterpret_cast< uint32_t* >(malloc(sizeof(uint32_t) * (nchars / 8 + 2)));
+	if (0 == off || 0 == out_off) {
+		fprintf(stderr, "error: out of memory\n");
+		free(off);
+		return;
+	}
+
+	// fields of 8 - 40 chars over the input, the last one cut short
+	corpus_rng rng = { 1 };
+	size_t count = 0;
+	off[0] = 0;
+	while (off[count] < nchars) {
+		size_t const end = off[count] + 8 + corpus_below(rng, 33);
+		off[++count] = uint32_t(end < nchars ? end : nchars);
+	}
+
+	measure_base(conf, "testee04", in, nchars, out, ref);
+
+	for (size_t k = 0; k < sizeof(ops) / sizeof(ops[0]); ++k) {
+		if (!ops[k].supported)
+			continue;
+
+		fields_arg const arg = { ops[k].fn, off, count, out_off };
+		bool match = fields_op(&arg, in, nchars, out) == out_off[count] && 0 == out_off[0];
+
+		for (size_t f = 0; f < count && match; ++f) {
+			size_t const len = off[f + 1] - off[f];
+			size_t const ref_len = prune_testee00(in + off[f], len, ref, len);
+			match = out_off[f + 1] - out_off[f] == ref_len && 0 == memcmp(out + out_off[f], ref, ref_len);
+		}
+
+		if (!match) {
+			printf("| %-10s | mismatch against testee00, field by field |\n", ops[k].name);
+			continue;
+		}
+
+		result res;
+		measure_op(conf, fields_op, &arg, in, nchars, out, res);
+		print_op(conf, ops[k].name, res);
+	}
+
+	free(out_off);
+	free(off);
+}
+
+static size_t adapt_op(
+	void const* const arg,
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out) {
+
+	return prune_adapt_run(**reinterpret_cast< prune_adapt* const* >(arg), in, len, out);
+}
+
+// -M adapt: the adaptive pruner against each of its candidates alone, over the mixed corpus by default; the chunks
+// pruned by each candidate, and the switches, are counted over a single pass
+static void bench_adapt(
+	bench_conf& conf,
+	uint8_t const* const in,
+	size_t const nchars,
+	uint8_t* const out,
+	uint8_t* const ref) {
+
+	prune_adapt st;
+	prune_adapt_init(st);
+
+	for (size_t k = 0; k < adapt_kinds; ++k)
+		if (st.table->cand[k])
+			measure_base(conf, st.table->cand[k]->name, in, nchars, out, ref);
+
+	size_t const ref_len = prune_testee00(in, nchars, ref, nchars);
+	if (prune_adapt_run(st, in, nchars, out) != ref_len || memcmp(out, ref, ref_len)) {
+		printf("| %-10s | mismatch against testee00 |\n", "adapt");
+		return;
+	}
+
+	// counters of the checked pass alone, before the timed ones add to them
+	uint64_t chunks[adapt_kinds];
+	uint64_t const switches = st.switches;
+	for (size_t k = 0; k < adapt_kinds; ++k)
+		chunks[k] = st.chunks[k];
+
+	prune_adapt* const arg = &st;
+	result res;
+	measure_op(conf, adapt_op, &arg, in, nchars, out, res);
+	print_op(conf, "adapt", res);
+
+	printf("\nchunks of %u chars in a pass:", unsigned(adapt_chunk));
+	for (size_t k = 0; k < adapt_kinds; ++k)
+		if (st.table->cand[k])
+			printf(" %s %llu%s", st.table->cand[k]->name, (unsigned long long) chunks[k],
+				k + 1 < adapt_kinds ? "," : "");
+
+	printf(" with %llu switches\n", (unsigned long long) switches);
+}
+
+static size_t json_op(
+	void const* const arg,
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out) {
+
+	json_state st = json_init();
+	return (*reinterpret_cast< json_fn const* >(arg))(in, len, out, st);
+}
+
+static size_t json_minify_op(
+	void const*,
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out) {
+
+	return json_minify(in, len, out);
+}
+
+// -M json: the minifiers of prune_json.h, and json_minify() by the one picked for the cpu, over json by default, next
+// to the pruners they build on, which prune the blanks of strings too; each is checked against the scalar minifier
+static void bench_json(
+	bench_conf& conf,
+	uint8_t const* const in,
+	size_t const nchars,
+	uint8_t* const out,
+	uint8_t* const ref) {
+
+	struct { char const* name; json_fn fn; bool supported; } const ops[] = {
+		{ "json00", json_testee00, true },
+#if __aarch64__
+		{ "json04", json_testee04, true },
+#elif __x86_64__ || __i386__
+		{ "json04", json_testee04, cpu_has_ssse3_popcnt() },
+#if __x86_64__
+		{ "json07", json_testee07, cpu_has_avx2_pclmul() },
+#endif
+#endif
+	};
+
+	measure_base(conf, "testee04", in, nchars, out, ref);
+	measure_base(conf, "testee07", in, nchars, out, ref);
+
+	json_state st = json_init();
+	size_t const ref_len = json_testee00(in, nchars, ref, st);
+
+	for (size_t k = 0; k < sizeof(ops) / sizeof(ops[0]) + 1; ++k) {
+		bool const minify = sizeof(ops) / sizeof(ops[0]) == k;
+		if (!minify && !ops[k].supported)
+			continue;
+
+		char const* const name = minify ? "minify" : ops[k].name;
+		bench_op const op = minify ? json_minify_op : json_op;
+		void const* const arg = minify ? 0 : &ops[k].fn;
+
+		if (op(arg, in, nchars, out) != ref_len || memcmp(out, ref, ref_len)) {
+			printf("| %-10s | mismatch against json00 |\n", name);
+			continue;
+		}
+
+		result res;
+		measure_op(conf, op, arg, in, nchars, out, res);
+		print_op(conf, name, res);
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t nchars = 0;
+	char const* kind = "pattern";
+	char const* file = 0;
+	double density = .2;
+	double run = 1.0;
+	bool sweep = false;
+	bool sweep_threads = false;
+	char const* corun_kind = 0;
+	size_t corun_kb = 32;
+	char const* mode = 0;
+
+	bench_conf conf;
+	conf.passes = 0;
+	conf.reps = 11;
+	conf.warmups = 2;
+	conf.threads = 1;
+	conf.lookback = false;
+	conf.inplace = false;
+	conf.feed = 0;
+	conf.mhz = 0.0;
+
+	int opt;
+	while (-1 != (opt = getopt(argc, argv, "n:p:r:w:c:t:LTPF:i:d:l:f:Sx:k:M:"))) {
+		switch (opt) {
+		case 'n':
+			nchars = strtoul(optarg, 0, 10);
+			break;
+		case 'p':
+			conf.passes = strtoul(optarg, 0, 10);
+			break;
+		case 'r':
+			conf.reps = strtoul(optarg, 0, 10);
+			break;
+		case 'w':
+			conf.warmups = strtoul(optarg, 0, 10);
+			break;
+		case 'c':
+			conf.mhz = strtod(optarg, 0);
+			break;
+		case 't':
+			conf.threads = strtoul(optarg, 0, 10);
+			break;
+		case 'L':
+			conf.lookback = true;
+			break;
+		case 'T':
+			sweep_threads = true;
+			break;
+		case 'P':
+			conf.inplace = true;
+			break;
+		case 'F':
+			conf.feed = strtoul(optarg, 0, 10);
+			break;
+		case 'i':
+			kind = optarg;
+			break;
+		case 'd':
+			density = strtod(optarg, 0) * 1e-2;
+			break;
+		case 'l':
+			run = strtod(optarg, 0);
+			break;
+		case 'f':
+			file = optarg;
+			break;
+		case 'S':
+			sweep = true;
+			kind = "density";
+			break;
+		case 'x':
+			corun_kind = optarg;
+			break;
+		case 'k':
+			corun_kb = strtoul(optarg, 0, 10);
+			break;
+		case 'M':
+			mode = optarg;
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-n chars] [-p passes] [-r reps] [-w warmups] [-c MHz] [-t threads] [-L] [-T] [-P]\n"
+				"\t[-F feed] [-i pattern|density|json|csv|log|source|mixed] [-d blank%%] [-l blank-run] [-f file] [-S]\n"
+				"\t[-x chase|copy] [-k KB] [-M collapse|map|fields|adapt|json] [pruner ...]\n", argv[0]);
+			return -1;
+		}
+	}
+
+	// the timing-loop pattern is of one density throughout, which gives the adaptive pruner nothing to adapt to, and
+	// has no strings for the minifiers to keep
+	if (mode && 0 == strcmp(mode, "adapt") && 0 == strcmp(kind, "pattern") && 0 == file)
+		kind = "mixed";
+	if (mode && 0 == strcmp(mode, "json") && 0 == strcmp(kind, "pattern") && 0 == file)
+		kind = "json";
+
+	// L1-resident for the timing-loop pattern, well out of L1 for the corpora, and out of any llc for thread sweeps
+	if (0 == nchars)
+		nchars = sweep_threads ? size_t(1) << 28 : 0 == strcmp(kind, "pattern") && 0 == file ? size_t(1) << 14 : size_t(1) << 20;
+
+	if (0 == conf.reps || 0 == conf.threads) {
+		fprintf(stderr, "error: reps and threads must be non-zero\n");
+		return -1;
+	}
+	if (sweep_threads && conf.inplace) {
+		fprintf(stderr, "error: thread sweeps compare two-pass pruning, which is out-of-place only\n");
+		return -1;
+	}
+	if (conf.feed && (sweep_threads || conf.inplace || 1 != conf.threads)) {
+		fprintf(stderr, "error: streams are single-threaded and out of place\n");
+		return -1;
+	}
+	if (corun_kind && (sweep || sweep_threads || conf.inplace || 1 != conf.threads)) {
+		fprintf(stderr, "error: co-runs are single-threaded, out of place, and not swept\n");
+		return -1;
+	}
+
+	if (mode && (sweep || sweep_threads || corun_kind || conf.feed || conf.inplace || 1 != conf.threads)) {
+		fprintf(stderr, "error: modes are single-threaded, out of place, unfed, and not swept or co-run\n");
+		return -1;
+	}
+	if (mode && strcmp(mode, "collapse") && strcmp(mode, "map") && strcmp(mode, "fields") && strcmp(mode, "adapt") &&
+		strcmp(mode, "json")) {
+		fprintf(stderr, "error: unknown mode %s\n", mode);
+		return -1;
+	}
+
+	corunner co = corunner();
+	if (corun_kind && !corun_init(co, corun_kind, corun_kb << 10)) {
+		fprintf(stderr, "error: cannot prepare co-runner %s\n", corun_kind);
+		return -1;
+	}
+
+	size_t const max_threads = sweep_threads && 1 == conf.threads ? size_t(sysconf(_SC_NPROCESSORS_ONLN)) : conf.threads;
+
+	// default passes to about 2^24 chars per rep
+	if (0 == conf.passes)
+		conf.passes = (size_t(1) << 24) / nchars + 1;
+
+	uint8_t* const in = reinterpret_cast< uint8_t* >(malloc(nchars));
+	uint8_t* const out = reinterpret_cast< uint8_t* >(malloc(nchars));
+	uint8_t* const ref = reinterpret_cast< uint8_t* >(malloc(nchars));
+
+	if (!sweep && !fill_input(in, nchars, kind, file, density, run)) {
+		fprintf(stderr, "error: cannot prepare input %s\n", file ? file : kind);
+		return -1;
+	}
+
+	conf.has_perf = perfcnt_open(conf.group);
+	conf.samples = reinterpret_cast< sample* >(malloc(sizeof(sample) * conf.reps));
+	conf.val = reinterpret_cast< double* >(malloc(sizeof(double) * conf.reps));
+
+	bool const has_clock = conf.has_perf || 0.0 != conf.mhz;
+	if (!has_clock)
+		fprintf(stderr, "warning: no perf counters and no clock given, reporting wall-clock figures only\n");
+
+	size_t count;
+	pruner const* const pruners = get_pruners(count);
+
+	if (mode) {
+		printf("%zu chars of %s x %zu passes, %zu reps after %zu warm-ups; %s\n\n",
+			nchars, file ? file : kind, conf.passes, conf.reps, conf.warmups, mode);
+		print_op_header();
+
+		if (0 == strcmp(mode, "collapse"))
+			bench_collapse(conf, in, nchars, out, ref);
+		else if (0 == strcmp(mode, "map"))
+			bench_map(conf, in, nchars, out, ref);
+		else if (0 == strcmp(mode, "fields"))
+			bench_fields(conf, in, nchars, out, ref);
+		else if (0 == strcmp(mode, "adapt"))
+			bench_adapt(conf, in, nchars, out, ref);
+		else
+			bench_json(conf, in, nchars, out, ref);
+	}
+	else if (sweep_threads) {
+		printf("%zu chars of %s x %zu passes, %zu reps after %zu warm-ups; median figures\n\n",
+			nchars, file ? file : kind, conf.passes, conf.reps, conf.warmups);
+		printf("|          |         | two-pass |        |         | look-back |        |         |\n");
+		printf("| pruner   | threads | chars/ns | GiB/s  | speedup | chars/ns  | GiB/s  | speedup |\n");
+		printf("| -------- | ------- | -------- | ------ | ------- | --------- | ------ | ------- |\n");
+
+		for (size_t k = 0; k < count; ++k) {
+			pruner const& pr = pruners[k];
+
+			if (!is_named(pr, argc, argv) || !pr.supported())
+				continue;
+
+			double base = 0.0;
+			for (size_t t = 1; t <= max_threads; t = t < max_threads && t * 2 > max_threads ? max_threads : t * 2) {
+				conf.threads = t;
+
+				result res[2];
+				bool match = true;
+				for (size_t lb = 0; lb < 2 && match; ++lb) {
+					conf.lookback = 0 != lb;
+					match = measure(conf, pr, in, nchars, out, ref, res[lb]);
+				}
+				if (!match) {
+					printf("| %-8s | %7zu | mismatch against testee00 |\n", pr.name, t);
+					break;
+				}
+				// both schemes fall back to the same single-threaded call
+				if (1 == t)
+					base = res[0].cpn_med;
+
+				printf("| %-8s | %7zu | %8.4f | %6.2f | %7.2f | %9.4f | %6.2f | %7.2f |\n", pr.name, t,
+					res[0].cpn_med, res[0].cpn_med * 1e9 / (1 << 30), res[0].cpn_med / base,
+					res[1].cpn_med, res[1].cpn_med * 1e9 / (1 << 30), res[1].cpn_med / base);
+				fflush(stdout);
+
+				if (t == max_threads)
+					break;
+			}
+		}
+	}
+	else if (sweep) {
+		printf("%zu chars x %zu passes%s, %zu reps after %zu warm-ups; blank runs of mean %.2f; %s\n\n",
+			nchars, conf.passes, conf.inplace ? " in place" : "", conf.reps, conf.warmups, run,
+			has_clock ? "median clocks/char" : "median chars/ns");
+
+		printf("| pruner   |");
+		for (size_t d = 0; d <= 100; d += 10)
+			printf(" %6zu%% |", d);
+		printf("\n| -------- |");
+		for (size_t d = 0; d <= 100; d += 10)
+			printf(" ------- |");
+		printf("\n");
+
+		for (size_t k = 0; k < count; ++k) {
+			pruner const& pr = pruners[k];
+
+			if (!is_named(pr, argc, argv) || !pr.supported())
+				continue;
+
+			printf("| %-8s |", pr.name);
+			for (size_t d = 0; d <= 100; d += 10) {
+				corpus_density(in, nchars, d * 1e-2, run);
+
+				result res;
+				if (!measure(conf, pr, in, nchars, out, ref, res))
+					printf(" %7s |", "mismatch");
+				else
+					printf(" %7.4f |", has_clock ? res.cpc_med : res.cpn_med);
+				fflush(stdout);
+			}
+			printf("\n");
+		}
+	}
+	else if (corun_kind) {
+		printf("%zu chars of %s x %zu passes, %zu reps after %zu warm-ups; co-run with %s over %zuKB every %d chars\n\n",
+			nchars, file ? file : kind, conf.passes, conf.reps, conf.warmups, corun_kind, co.size >> 10, int(corun_chunk));
+		printf("| pruner   | clocks/char solo | clocks/char co-run | chars/ns solo | chars/ns co-run | sweep ns solo | sweep ns co-run | co-runner slowdown |\n");
+		printf("| -------- | ---------------- | ------------------ | ------------- | --------------- | ------------- | --------------- | ------------------ |\n");
+
+		for (size_t k = 0; k < count; ++k) {
+			pruner const& pr = pruners[k];
+
+			if (!is_named(pr, argc, argv) || !pr.supported())
+				continue;
+
+			result solo;
+			if (!measure(conf, pr, in, nchars, out, ref, solo)) {
+				printf("| %-8s | mismatch against testee00 |\n", pr.name);
+				continue;
+			}
+
+			double const mhz = 0.0 != conf.mhz ? conf.mhz : solo.mhz_med;
+			corun_result res;
+			measure_corun(conf, pr, in, nchars, out, co, mhz, res);
+
+			double const slowdown = (res.sweep_ns / res.sweep_solo_ns - 1.0) * 100.0;
+			if (0.0 != mhz)
+				printf("| %-8s | %16.4f | %18.4f | %13.4f | %15.4f | %13.1f | %15.1f | %17.1f%% |\n", pr.name,
+					solo.cpc_med, res.cpc_med, solo.cpn_med, res.cpn_med, res.sweep_solo_ns, res.sweep_ns, slowdown);
+			else
+				printf("| %-8s | %16s | %18s | %13.4f | %15.4f | %13.1f | %15.1f | %17.1f%% |\n", pr.name,
+					"-", "-", solo.cpn_med, res.cpn_med, res.sweep_solo_ns, res.sweep_ns, slowdown);
+			fflush(stdout);
+		}
+		free(co.buf);
+	}
+	else {
+		printf("%zu chars of %s x %zu passes%s, %zu reps after %zu warm-ups; best pick for this cpu: %s\n\n",
+			nchars, file ? file : kind, conf.passes, conf.inplace ? " in place" : "", conf.reps, conf.warmups,
+			select_pruner()->name);
+		printf("| pruner   | batch | clocks/char min | clocks/char median | IPC median | chars/ns median | GiB/s median |\n");
+		printf("| -------- | ----- | --------------- | ------------------ | ---------- | --------------- | ------------ |\n");
+
+		for (size_t k = 0; k < count; ++k) {
+			pruner const& pr = pruners[k];
+
+			if (!is_named(pr, argc, argv) || !pr.supported())
+				continue;
+
+			result res;
+			if (!measure(conf, pr, in, nchars, out, ref, res)) {
+				printf("| %-8s | %5zu | mismatch against testee00 |\n", pr.name, pr.batch);
+				continue;
+			}
+
+			if (conf.has_perf)
+				printf("| %-8s | %5zu | %15.4f | %18.4f | %10.2f | %15.4f | %12.2f |\n",
+					pr.name, pr.batch, res.cpc_min, res.cpc_med, res.ipc_med, res.cpn_med, res.cpn_med * 1e9 / (1 << 30));
+			else if (has_clock)
+				printf("| %-8s | %5zu | %15.4f | %18.4f | %10s | %15.4f | %12.2f |\n",
+					pr.name, pr.batch, res.cpc_min, res.cpc_med, "-", res.cpn_med, res.cpn_med * 1e9 / (1 << 30));
+			else
+				printf("| %-8s | %5zu | %15s | %18s | %10s | %15.4f | %12.2f |\n",
+					pr.name, pr.batch, "-", "-", "-", res.cpn_med, res.cpn_med * 1e9 / (1 << 30));
+		}
+	}
+
+	perfcnt_close(conf.group);
+	free(conf.val);
+	free(conf.samples);
+	free(ref);
+	free(out);
+	free(in);
+	return 0;
+}
@@ -0,0 +1,303 @@
+// input corpora for benchmarking the pruners -- synthetic text of controlled blank density and run length, and
+// synthetic samples of common formats, all deterministic for a given seed
+#ifndef CORPUS_H_
+#define CORPUS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+// xorshift64*, good enough for text generation
+struct corpus_rng {
+	uint64_t s;
+};
+
+inline uint64_t corpus_next(corpus_rng& rng) {
+	rng.s ^= rng.s >> 12;
+	rng.s ^= rng.s << 25;
+	rng.s ^= rng.s >> 27;
+	return rng.s * 0x2545f4914f6cdd1dull;
+}
+
+// uniform in [0, n)
+inline uint32_t corpus_below(corpus_rng& rng, uint32_t const n) {
+	return uint32_t((corpus_next(rng) >> 32) * n >> 32);
+}
+
+// uniform in [0, 1)
+inline double corpus_unit(corpus_rng& rng) {
+	return double(corpus_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+// geometric run length of the given mean, at least 1
+inline size_t corpus_run(corpus_rng& rng, double const mean) {
+	if (mean <= 1.0)
+		return 1;
+
+	double const p = 1.0 / mean;
+	size_t len = 1;
+	while (corpus_unit(rng) >= p && len < (size_t(1) << 20))
+		++len;
+
+	return len;
+}
+
+inline uint8_t corpus_blank(corpus_rng& rng) {
+	static uint8_t const blank[] = { ' ', ' ', ' ', ' ', ' ', ' ', '\t', '\n' };
+	return blank[corpus_below(rng, sizeof(blank))];
+}
+
+inline uint8_t corpus_nonblank(corpus_rng& rng) {
+	return uint8_t('!' + corpus_below(rng, '~' - '!' + 1));
+}
+
+// text of the given blank density in [0, 1], with blank runs of the given mean length; runs alternate between blank
+// and non-blank, the mean of the latter chosen to hit the density
+inline void corpus_density(
+	uint8_t* const buf,
+	size_t const len,
+	double const density,
+	double const run,
+	uint64_t const seed = 1) {
+
+	corpus_rng rng = { seed | 1 };
+
+	if (density <= 0.0) {
+		for (size_t i = 0; i < len; ++i)
+			buf[i] = corpus_nonblank(rng);
+		return;
+	}
+	if (density >= 1.0) {
+		for (size_t i = 0; i < len; ++i)
+			buf[i] = corpus_blank(rng);
+		return;
+	}
+
+	double const run_blank = run < 1.0 ? 1.0 : run;
+	double const run_nonblank = run_blank * (1.0 - density) / density;
+
+	// start at random phase, so short buffers are not biased to either kind
+	bool blank = corpus_unit(rng) < density;
+	for (size_t i = 0; i < len; blank = !blank) {
+		size_t const n = corpus_run(rng, blank ? run_blank : run_nonblank);
+		for (size_t j = 0; j < n && i < len; ++j, ++i)
+			buf[i] = blank ? corpus_blank(rng) : corpus_nonblank(rng);
+	}
+}
+
+// append helper: copies as much of str as fits; returns the new fill
+inline size_t corpus_put(
+	uint8_t* const buf,
+	size_t const len,
+	size_t pos,
+	char const* const str) {
+
+	for (size_t i = 0; str[i] && pos < len; ++i)
+		buf[pos++] = uint8_t(str[i]);
+
+	return pos;
+}
+
+inline size_t corpus_put_indent(
+	uint8_t* const buf,
+	size_t const len,
+	size_t pos,
+	size_t const depth,
+	char const* const unit) {
+
+	for (size_t i = 0; i < depth; ++i)
+		pos = corpus_put(buf, len, pos, unit);
+
+	return pos;
+}
+
+static char const* const corpus_words[] = {
+	"alpha", "beta", "gamma", "delta", "request", "response", "user", "session", "token", "value", "count", "status",
+	"error", "timeout", "worker", "queue", "cache", "index", "shard", "batch", "offset", "length", "name", "id",
+};
+
+inline char const* corpus_word(corpus_rng& rng) {
+	return corpus_words[corpus_below(rng, sizeof(corpus_words) / sizeof(corpus_words[0]))];
+}
+
+// pretty-printed json, 2-space indent, with blanks inside string values too
+inline void corpus_json(
+	uint8_t* const buf,
+	size_t const len,
+	uint64_t const seed = 1) {
+
+	corpus_rng rng = { seed | 1 };
+	size_t pos = 0;
+	char tmp[64];
+
+	while (pos < len) {
+		pos = corpus_put(buf, len, pos, "{\n");
+		size_t const fields = 3 + corpus_below(rng, 6);
+
+		for (size_t f = 0; f < fields; ++f) {
+			pos = corpus_put_indent(buf, len, pos, 1, "  ");
+			snprintf(tmp, sizeof(tmp), "\"%s_%s\": ", corpus_word(rng), corpus_word(rng));
+			pos = corpus_put(buf, len, pos, tmp);
+
+			switch (corpus_below(rng, 4)) {
+			case 0:
+				snprintf(tmp, sizeof(tmp), "%u", corpus_below(rng, 100000));
+				break;
+			case 1:
+				snprintf(tmp, sizeof(tmp), "\"%s %s %s\"", corpus_word(rng), corpus_word(rng), corpus_word(rng));
+				break;
+			case 2:
+				snprintf(tmp, sizeof(tmp), "[ %u, %u, %u ]", corpus_below(rng, 1000), corpus_below(rng, 1000), corpus_below(rng, 1000));
+				break;
+			default:
+				snprintf(tmp, sizeof(tmp), "{\n    \"%s\": %s\n  }", corpus_word(rng), corpus_below(rng, 2) ? "true" : "null");
+				break;
+			}
+
+			pos = corpus_put(buf, len, pos, tmp);
+			pos = corpus_put(buf, len, pos, f + 1 < fields ? ",\n" : "\n");
+		}
+
+		pos = corpus_put(buf, len, pos, "}\n");
+	}
+}
+
+// csv with blank-padded cells
+inline void corpus_csv(
+	uint8_t* const buf,
+	size_t const len,
+	uint64_t const seed = 1) {
+
+	corpus_rng rng = { seed | 1 };
+	size_t pos = 0;
+	char tmp[64];
+
+	while (pos < len) {
+		for (size_t c = 0; c < 6; ++c) {
+			switch (c) {
+			case 0:
+				snprintf(tmp, sizeof(tmp), "%u", corpus_below(rng, 1000000));
+				break;
+			case 1:
+			case 2:
+				snprintf(tmp, sizeof(tmp), " %s", corpus_word(rng));
+				break;
+			case 3:
+				snprintf(tmp, sizeof(tmp), " %8u.%02u", corpus_below(rng, 100000), corpus_below(rng, 100));
+				break;
+			default:
+				snprintf(tmp, sizeof(tmp), " %s %s", corpus_word(rng), corpus_word(rng));
+				break;
+			}
+
+			pos = corpus_put(buf, len, pos, tmp);
+			pos = corpus_put(buf, len, pos, c < 5 ? "," : "\n");
+		}
+	}
+}
+
+// service log lines
+inline void corpus_log(
+	uint8_t* const buf,
+	size_t const len,
+	uint64_t const seed = 1) {
+
+	static char const* const level[] = { "INFO ", "INFO ", "INFO ", "DEBUG", "WARN ", "ERROR" };
+
+	corpus_rng rng = { seed | 1 };
+	size_t pos = 0;
+	char tmp[160];
+
+	for (uint32_t t = 0; pos < len; t += corpus_below(rng, 50)) {
+		snprintf(tmp, sizeof(tmp), "2026-10-17T03:%02u:%02u.%03uZ %s [worker-%u] %s %s id=%08x took %u ms\n",
+			t / 60000 % 60, t / 1000 % 60, t % 1000, level[corpus_below(rng, sizeof(level) / sizeof(level[0]))],
+			corpus_below(rng, 64), corpus_word(rng), corpus_word(rng), uint32_t(corpus_next(rng)), corpus_below(rng, 500));
+		pos = corpus_put(buf, len, pos, tmp);
+	}
+}
+
+// c-like source, tab-indented
+inline void corpus_source(
+	uint8_t* const buf,
+	size_t const len,
+	uint64_t const seed = 1) {
+
+	corpus_rng rng = { seed | 1 };
+	size_t pos = 0;
+	char tmp[128];
+
+	while (pos < len) {
+		snprintf(tmp, sizeof(tmp), "// %s the %s of a %s\nstatic size_t %s_%s(\n\tuint8_t const* const %s,\n\tsize_t const %s) {\n\n",
+			corpus_word(rng), corpus_word(rng), corpus_word(rng), corpus_word(rng), corpus_word(rng), corpus_word(rng), corpus_word(rng));
+		pos = corpus_put(buf, len, pos, tmp);
+
+		size_t const lines = 2 + corpus_below(rng, 8);
+		for (size_t l = 0; l < lines; ++l) {
+			size_t const depth = 1 + corpus_below(rng, 3);
+			pos = corpus_put_indent(buf, len, pos, depth, "\t");
+
+			switch (corpus_below(rng, 3)) {
+			case 0:
+				snprintf(tmp, sizeof(tmp), "size_t const %s = %s + %u;\n", corpus_word(rng), corpus_word(rng), corpus_below(rng, 64));
+				break;
+			case 1:
+				snprintf(tmp, sizeof(tmp), "if (%s < %s)\n", corpus_word(rng), corpus_word(rng));
+				break;
+			default:
+				snprintf(tmp, sizeof(tmp), "%s[%s] = %s(%s, %u); // %s\n",
+					corpus_word(rng), corpus_word(rng), corpus_word(rng), corpus_word(rng), corpus_below(rng, 16), corpus_word(rng));
+				break;
+			}
+
+			pos = corpus_put(buf, len, pos, tmp);
+		}
+
+		pos = corpus_put(buf, len, pos, "\treturn 0;\n}\n\n");
+	}
+}
+
+// stretches of 64KB of density text, cycling through densities from none to all blanks, with blank runs alternating
+// between single chars and long ones -- input on which no one pruner is the fastest throughout
+inline void corpus_mixed(
+	uint8_t* const buf,
+	size_t const len,
+	uint64_t const seed = 1) {
+
+	static double const density[] = { 0.0, 0.01, 0.2, 0.5, 1.0, 0.95, 0.002 };
+	size_t const stretch = size_t(1) << 16;
+
+	for (size_t i = 0, k = 0; i < len; i += stretch, ++k) {
+		size_t const n = len - i < stretch ? len - i : stretch;
+		size_t const d = k % (sizeof(density) / sizeof(density[0]));
+		corpus_density(buf + i, n, density[d], k & 1 ? 12.0 : 1.0, seed + 2 * k);
+	}
+}
+
+// fill the buffer with the given file, repeated as needed; false on error or an empty file
+inline bool corpus_file(
+	uint8_t* const buf,
+	size_t const len,
+	char const* const name) {
+
+	FILE* const f = fopen(name, "rb");
+	if (0 == f)
+		return false;
+
+	size_t pos = 0;
+	while (pos < len) {
+		size_t const n = fread(buf + pos, 1, len - pos, f);
+		if (0 == n) {
+			if (0 == pos || ferror(f))
+				break;
+			rewind(f);
+			continue;
+		}
+		pos += n;
+	}
+
+	fclose(f);
+	return pos == len;
+}
+
+#endif // CORPUS_H_
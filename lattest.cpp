@@ -1,103 +1,544 @@
-// latency/tput calculator -- a chain of ops with data dependency between each two ops;
-// to break the dependency set COISSUE
+// latency/tput profiler -- the ops the pruners are made of, each timed in a chain of 8 ops with data dependency between
+// each two ops, for its latency, and in 8 independent chains, for its reciprocal throughput; from those, and the op mix
+// of each pruner, bounds on the pruners' clocks/char
+//
+// build: g++ -O3 lattest.cpp -o lattest
+// usage: lattest [-c MHz] [-r reps] [-n runs]
+//
+// Cycles come from perf_event_open when available (see perf_event_paranoid); otherwise clocks derive from wall time at
+// the clock given by -c, as lattest.sh does, or only ns figures are given. Each figure is the best of -n runs of -r
+// reps of 8 ops.
+//
+// The issue bound of a pruner is the sum of each op's count times its reciprocal throughput, as if all ops shared the
+// same pipes; the latency bound is the sum of the latencies along a batch's dependency chain, shared by the batches a
+// pruner takes in lockstep. A core that overlaps successive batches runs close to the former, one that does not close
+// to the latter, so the prediction is the greater of the two. Loads, stores, moves and scalar bookkeeping are left out,
+// while ops that issue on separate pipes are counted as if they contended, so neither is strict: they rank pruners
+// and tell which limit each runs into, rather than time it.
 
-#if __aarch64__ == 0 && __SSSE3__ == 0
+#if __aarch64__ == 0 && __x86_64__ == 0
 	#error wrong target arch
 #endif
 
-#include <stddef.h>
+#include "prune.h"
+#include "perfcnt.h"
+#include <initializer_list>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
 
-int main(int, char**) {
-	size_t const rep = size_t(2e9);
+#if __aarch64__
+// ops by the v-registers they take: a chain runs through v16, with v17 for a second table register -- a tbl takes
+// consecutive ones; the independent chains run through v16, v18, ... v30, each with the one above; v0 is a source left
+// alone, for ops that would be moves otherwise
+#define LATTEST_CHAIN(op) \
+	op(16, 17) op(16, 17) op(16, 17) op(16, 17) op(16, 17) op(16, 17) op(16, 17) op(16, 17)
+#define LATTEST_COISSUE(op) \
+	op(16, 17) op(18, 19) op(20, 21) op(22, 23) op(24, 25) op(26, 27) op(28, 29) op(30, 31)
+#define LATTEST_CLOBBER \
+	"v16", "v17", "v18", "v19", "v20", "v21", "v22", "v23", "v24", "v25", "v26", "v27", "v28", "v29", "v30", "v31"
+#define LATTEST_TARGET_any
+#define LATTEST_HAS_any cpu_any
 
-	for (size_t i = 0; i < rep; ++i) {
+#define OP_BIN(mnemonic, arr, n) mnemonic " v" #n arr ", v" #n arr ", v" #n arr "\n\t"
+#define OP_TBL1_Q(n, m)  "tbl v" #n ".16b, {v" #n ".16b}, v" #n ".16b\n\t"
+#define OP_TBL1_D(n, m)  "tbl v" #n ".8b, {v" #n ".16b}, v" #n ".8b\n\t"
+#define OP_TBL2_Q(n, m)  "tbl v" #n ".16b, {v" #n ".16b, v" #m ".16b}, v" #n ".16b\n\t"
+#define OP_TBL2_D(n, m)  "tbl v" #n ".8b, {v" #n ".16b, v" #m ".16b}, v" #n ".8b\n\t"
+#define OP_UZP1_Q(n, m)  OP_BIN("uzp1", ".16b", n)
+#define OP_UZP1_D(n, m)  OP_BIN("uzp1", ".8b", n)
+#define OP_UZP2_Q(n, m)  OP_BIN("uzp2", ".16b", n)
+#define OP_UZP2_D(n, m)  OP_BIN("uzp2", ".8b", n)
+#define OP_TRN1_Q(n, m)  OP_BIN("trn1", ".16b", n)
+#define OP_TRN1_D(n, m)  OP_BIN("trn1", ".8b", n)
+#define OP_TRN2_Q(n, m)  OP_BIN("trn2", ".16b", n)
+#define OP_TRN2_D(n, m)  OP_BIN("trn2", ".8b", n)
+#define OP_REV16_Q(n, m) "rev16 v" #n ".16b, v" #n ".16b\n\t"
+#define OP_REV16_D(n, m) "rev16 v" #n ".8b, v" #n ".8b\n\t"
+#define OP_UMIN_Q(n, m)  OP_BIN("umin", ".16b", n)
+#define OP_UMIN_D(n, m)  OP_BIN("umin", ".8b", n)
+#define OP_UMAX_Q(n, m)  OP_BIN("umax", ".16b", n)
+#define OP_UMAX_D(n, m)  OP_BIN("umax", ".8b", n)
+#define OP_ZIP1_H(n, m)  OP_BIN("zip1", ".8h", n)
+#define OP_ZIP2_H(n, m)  OP_BIN("zip2", ".8h", n)
+#define OP_ADD_Q(n, m)   OP_BIN("add", ".16b", n)
+#define OP_ADDP_Q(n, m)  OP_BIN("addp", ".16b", n)
+#define OP_ADDP_D(n, m)  OP_BIN("addp", ".8b", n)
+#define OP_ADDV_Q(n, m)  "addv b" #n ", v" #n ".16b\n\t"
+#define OP_ADDV_D(n, m)  "addv b" #n ", v" #n ".8b\n\t"
+#define OP_CMHS_Q(n, m)  OP_BIN("cmhs", ".16b", n)
+#define OP_CMHS_D(n, m)  OP_BIN("cmhs", ".8b", n)
+#define OP_ORR_Q(n, m)   "orr v" #n ".16b, v" #n ".16b, v0.16b\n\t"
+#define OP_ORR_D(n, m)   "orr v" #n ".8b, v" #n ".8b, v0.8b\n\t"
 
-#if __aarch64__
-#if COISSUE
-		asm volatile (
-			"tbl v17.16b, {v1.16b},  v0.16b\n\t"
-			"tbl v18.16b, {v2.16b},  v0.16b\n\t"
-			"tbl v19.16b, {v3.16b},  v0.16b\n\t"
-			"tbl v20.16b, {v4.16b},  v0.16b\n\t"
-			"tbl v21.16b, {v5.16b},  v0.16b\n\t"
-			"tbl v22.16b, {v6.16b},  v0.16b\n\t"
-			"tbl v23.16b, {v7.16b},  v0.16b\n\t"
-			"tbl v24.16b, {v8.16b},  v0.16b\n\t"
-			"tbl v25.16b, {v9.16b},  v0.16b\n\t"
-			"tbl v26.16b, {v10.16b}, v0.16b\n\t"
-			"tbl v27.16b, {v11.16b}, v0.16b\n\t"
-			"tbl v28.16b, {v12.16b}, v0.16b\n\t"
-			"tbl v29.16b, {v13.16b}, v0.16b\n\t"
-			"tbl v30.16b, {v14.16b}, v0.16b\n\t"
-			"tbl v31.16b, {v15.16b}, v0.16b\n\t"
-			"tbl v16.16b, {v16.16b}, v0.16b"
-			: : : "memory");
-
-#else
-		asm volatile (
-			"tbl v2.16b,  {v1.16b},  v0.16b\n\t"
-			"tbl v3.16b,  {v2.16b},  v0.16b\n\t"
-			"tbl v4.16b,  {v3.16b},  v0.16b\n\t"
-			"tbl v5.16b,  {v4.16b},  v0.16b\n\t"
-			"tbl v6.16b,  {v5.16b},  v0.16b\n\t"
-			"tbl v7.16b,  {v6.16b},  v0.16b\n\t"
-			"tbl v8.16b,  {v7.16b},  v0.16b\n\t"
-			"tbl v9.16b,  {v8.16b},  v0.16b\n\t"
-			"tbl v10.16b, {v9.16b},  v0.16b\n\t"
-			"tbl v11.16b, {v10.16b}, v0.16b\n\t"
-			"tbl v12.16b, {v11.16b}, v0.16b\n\t"
-			"tbl v13.16b, {v12.16b}, v0.16b\n\t"
-			"tbl v14.16b, {v13.16b}, v0.16b\n\t"
-			"tbl v15.16b, {v14.16b}, v0.16b\n\t"
-			"tbl v16.16b, {v15.16b}, v0.16b\n\t"
-			"tbl v1.16b,  {v16.16b}, v0.16b"
-			: : : "memory");
+#define LATTEST_OPS(X) \
+	X(tbl1_q,  "tbl1.16b",  OP_TBL1_Q,  any) \
+	X(tbl1_d,  "tbl1.8b",   OP_TBL1_D,  any) \
+	X(tbl2_q,  "tbl2.16b",  OP_TBL2_Q,  any) \
+	X(tbl2_d,  "tbl2.8b",   OP_TBL2_D,  any) \
+	X(uzp1_q,  "uzp1.16b",  OP_UZP1_Q,  any) \
+	X(uzp1_d,  "uzp1.8b",   OP_UZP1_D,  any) \
+	X(uzp2_q,  "uzp2.16b",  OP_UZP2_Q,  any) \
+	X(uzp2_d,  "uzp2.8b",   OP_UZP2_D,  any) \
+	X(trn1_q,  "trn1.16b",  OP_TRN1_Q,  any) \
+	X(trn1_d,  "trn1.8b",   OP_TRN1_D,  any) \
+	X(trn2_q,  "trn2.16b",  OP_TRN2_Q,  any) \
+	X(trn2_d,  "trn2.8b",   OP_TRN2_D,  any) \
+	X(zip1_h,  "zip1.8h",   OP_ZIP1_H,  any) \
+	X(zip2_h,  "zip2.8h",   OP_ZIP2_H,  any) \
+	X(rev16_q, "rev16.16b", OP_REV16_Q, any) \
+	X(rev16_d, "rev16.8b",  OP_REV16_D, any) \
+	X(umin_q,  "umin.16b",  OP_UMIN_Q,  any) \
+	X(umin_d,  "umin.8b",   OP_UMIN_D,  any) \
+	X(umax_q,  "umax.16b",  OP_UMAX_Q,  any) \
+	X(umax_d,  "umax.8b",   OP_UMAX_D,  any) \
+	X(add_q,   "add.16b",   OP_ADD_Q,   any) \
+	X(addp_q,  "addp.16b",  OP_ADDP_Q,  any) \
+	X(addp_d,  "addp.8b",   OP_ADDP_D,  any) \
+	X(addv_q,  "addv.16b",  OP_ADDV_Q,  any) \
+	X(addv_d,  "addv.8b",   OP_ADDV_D,  any) \
+	X(cmhs_q,  "cmhs.16b",  OP_CMHS_Q,  any) \
+	X(cmhs_d,  "cmhs.8b",   OP_CMHS_D,  any) \
+	X(orr_q,   "orr.16b",   OP_ORR_Q,   any) \
+	X(orr_d,   "orr.8b",    OP_ORR_D,   any)
+
+#elif __x86_64__
+// ops by the registers they take: a chain runs through xmm0, with r8 for a gpr; the independent chains run through
+// xmm0 - 7, with r8 - 15; xmm15 is a source left alone, for ops that would be dependency-breaking idioms otherwise;
+// pmovmskb and pextrq go back to their xmm by movd or movq, so their figures are of the round trip; the avx2 ops take
+// the ymm of the same numbers
+#define LATTEST_CHAIN(op) \
+	op(0, 8) op(0, 8) op(0, 8) op(0, 8) op(0, 8) op(0, 8) op(0, 8) op(0, 8)
+#define LATTEST_COISSUE(op) \
+	op(0, 8) op(1, 9) op(2, 10) op(3, 11) op(4, 12) op(5, 13) op(6, 14) op(7, 15)
+#define LATTEST_CLOBBER \
+	"xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7", "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15"
+#define LATTEST_TARGET_ssse3 TARGET_SSSE3_POPCNT
+#define LATTEST_TARGET_avx2 TARGET_AVX2
+#define LATTEST_HAS_ssse3 cpu_has_ssse3_popcnt
+#define LATTEST_HAS_avx2 cpu_has_avx2_popcnt
+
+#define OP_PSHUFB(n, m)     "pshufb %%xmm" #n ", %%xmm" #n "\n\t"
+#define OP_PMINUB(n, m)     "pminub %%xmm" #n ", %%xmm" #n "\n\t"
+#define OP_PMAXUB(n, m)     "pmaxub %%xmm" #n ", %%xmm" #n "\n\t"
+#define OP_PUNPCKLQDQ(n, m) "punpcklqdq %%xmm" #n ", %%xmm" #n "\n\t"
+#define OP_PSHUFD(n, m)     "pshufd $0x55, %%xmm" #n ", %%xmm" #n "\n\t"
+#define OP_PCMPGTB(n, m)    "pcmpgtb %%xmm15, %%xmm" #n "\n\t"
+#define OP_PCMPEQB(n, m)    "pcmpeqb %%xmm15, %%xmm" #n "\n\t"
+#define OP_POR(n, m)        "por %%xmm15, %%xmm" #n "\n\t"
+#define OP_PMOVMSKB(n, m)   "pmovmskb %%xmm" #n ", %%r" #m "d\n\tmovd %%r" #m "d, %%xmm" #n "\n\t"
+#define OP_POPCNT(n, m)     "popcnt %%r" #m ", %%r" #m "\n\t"
+
+#define OP_VBIN(mnemonic, n)  mnemonic " %%ymm" #n ", %%ymm" #n ", %%ymm" #n "\n\t"
+#define OP_VPSHUFB(n, m)      OP_VBIN("vpshufb", n)
+#define OP_VPMINUB(n, m)      OP_VBIN("vpminub", n)
+#define OP_VPMAXUB(n, m)      OP_VBIN("vpmaxub", n)
+#define OP_VPUNPCKLQDQ(n, m)  OP_VBIN("vpunpcklqdq", n)
+#define OP_VPCMPGTB(n, m)     "vpcmpgtb %%ymm" #n ", %%ymm15, %%ymm" #n "\n\t"
+#define OP_VPOR(n, m)         "vpor %%ymm15, %%ymm" #n ", %%ymm" #n "\n\t"
+#define OP_VPMOVMSKB(n, m)    "vpmovmskb %%ymm" #n ", %%r" #m "d\n\tvmovd %%r" #m "d, %%xmm" #n "\n\t"
+#define OP_VEXTRACTI128(n, m) "vextracti128 $1, %%ymm" #n ", %%xmm" #n "\n\t"
+#define OP_VPEXTRQ(n, m)      "vpextrq $1, %%xmm" #n ", %%r" #m "\n\tvmovq %%r" #m ", %%xmm" #n "\n\t"
+
+#define LATTEST_OPS(X) \
+	X(pshufb,       "pshufb",       OP_PSHUFB,       ssse3) \
+	X(pminub,       "pminub",       OP_PMINUB,       ssse3) \
+	X(pmaxub,       "pmaxub",       OP_PMAXUB,       ssse3) \
+	X(punpcklqdq,   "punpcklqdq",   OP_PUNPCKLQDQ,   ssse3) \
+	X(pshufd,       "pshufd",       OP_PSHUFD,       ssse3) \
+	X(pcmpgtb,      "pcmpgtb",      OP_PCMPGTB,      ssse3) \
+	X(pcmpeqb,      "pcmpeqb",      OP_PCMPEQB,      ssse3) \
+	X(por,          "por",          OP_POR,          ssse3) \
+	X(pmovmskb,     "pmovmskb",     OP_PMOVMSKB,     ssse3) \
+	X(popcnt,       "popcnt",       OP_POPCNT,       ssse3) \
+	X(vpshufb,      "vpshufb",      OP_VPSHUFB,      avx2)  \
+	X(vpminub,      "vpminub",      OP_VPMINUB,      avx2)  \
+	X(vpmaxub,      "vpmaxub",      OP_VPMAXUB,      avx2)  \
+	X(vpunpcklqdq,  "vpunpcklqdq",  OP_VPUNPCKLQDQ,  avx2)  \
+	X(vpcmpgtb,     "vpcmpgtb",     OP_VPCMPGTB,     avx2)  \
+	X(vpor,         "vpor",         OP_VPOR,         avx2)  \
+	X(vpmovmskb,    "vpmovmskb",    OP_VPMOVMSKB,    avx2)  \
+	X(vextracti128, "vextracti128", OP_VEXTRACTI128, avx2)  \
+	X(vpextrq,      "vpextrq",      OP_VPEXTRQ,      avx2)
 
 #endif
-#elif __SSSE3__
-#if COISSUE
-		asm volatile (
-			"pshufb %%xmm0,  %%xmm1\n\t"
-			"pshufb %%xmm0,  %%xmm2\n\t"
-			"pshufb %%xmm0,  %%xmm3\n\t"
-			"pshufb %%xmm0,  %%xmm4\n\t"
-			"pshufb %%xmm0,  %%xmm5\n\t"
-			"pshufb %%xmm0,  %%xmm6\n\t"
-			"pshufb %%xmm0,  %%xmm7\n\t"
-			"pshufb %%xmm0,  %%xmm8\n\t"
-			"pshufb %%xmm0,  %%xmm9\n\t"
-			"pshufb %%xmm0, %%xmm10\n\t"
-			"pshufb %%xmm0, %%xmm11\n\t"
-			"pshufb %%xmm0, %%xmm12\n\t"
-			"pshufb %%xmm0, %%xmm13\n\t"
-			"pshufb %%xmm0, %%xmm14\n\t"
-			"pshufb %%xmm0, %%xmm15\n\t"
-			"pshufb %%xmm0, %%xmm8"
-			: : : "memory");
-
-#else
-		asm volatile (
-			"pshufb %%xmm0,  %%xmm1\n\t"
-			"pshufb %%xmm1,  %%xmm2\n\t"
-			"pshufb %%xmm2,  %%xmm3\n\t"
-			"pshufb %%xmm3,  %%xmm4\n\t"
-			"pshufb %%xmm4,  %%xmm5\n\t"
-			"pshufb %%xmm5,  %%xmm6\n\t"
-			"pshufb %%xmm6,  %%xmm7\n\t"
-			"pshufb %%xmm7,  %%xmm8\n\t"
-			"pshufb %%xmm8,  %%xmm9\n\t"
-			"pshufb %%xmm9,  %%xmm10\n\t"
-			"pshufb %%xmm10, %%xmm11\n\t"
-			"pshufb %%xmm11, %%xmm12\n\t"
-			"pshufb %%xmm12, %%xmm13\n\t"
-			"pshufb %%xmm13, %%xmm14\n\t"
-			"pshufb %%xmm14, %%xmm15\n\t"
-			"pshufb %%xmm15, %%xmm0"
-			: : : "memory");
+// a chain and a coissue runner per op, built for the op's isa, and the ops' table, in the order of their enum
+#define LATTEST_RUNNERS(fn, name, op, isa) \
+	LATTEST_TARGET_##isa static void fn##_chain(size_t const reps) { \
+		for (size_t i = 0; i < reps; ++i) \
+			asm volatile (LATTEST_CHAIN(op) : : : LATTEST_CLOBBER); \
+	} \
+	LATTEST_TARGET_##isa static void fn##_coissue(size_t const reps) { \
+		for (size_t i = 0; i < reps; ++i) \
+			asm volatile (LATTEST_COISSUE(op) : : : LATTEST_CLOBBER); \
+	}
+#define LATTEST_ENUM(fn, name, op, isa) op_##fn,
+#define LATTEST_DESC(fn, name, op, isa) { name, fn##_chain, fn##_coissue, LATTEST_HAS_##isa },
+
+LATTEST_OPS(LATTEST_RUNNERS)
+
+enum {
+	LATTEST_OPS(LATTEST_ENUM)
+
+	op_count
+};
+
+struct op_desc {
+	char const* name;
+	void (*chain)(size_t reps);
+	void (*coissue)(size_t reps);
+	bool (*supported)();
+};
+
+static op_desc const op_table[op_count] = {
+	LATTEST_OPS(LATTEST_DESC)
+};
+
+// op figures, in clocks, or ns without a clock
+struct op_time {
+	double lat;
+	double rtput;
+};
+
+// op mix of a pruner: per 16 wires of its network, the count of each op, and how many of those are on the chain
+struct mix_use {
+	uint8_t op;
+	uint8_t count;
+	uint8_t chain;
+};
+
+struct mix {
+	char const* name;
+	size_t wires; // chars per batch of one network
+	size_t ways;  // batches in lockstep
+	size_t uses;
+	mix_use use[op_count];
+};
+
+static void mix_add(
+	mix& m,
+	uint8_t const op,
+	size_t const count,
+	size_t const chain) {
+
+	if (0 == count)
+		return;
+
+	for (size_t i = 0; i < m.uses; ++i)
+		if (op == m.use[i].op) {
+			m.use[i].count += count;
+			m.use[i].chain += chain;
+			return;
+		}
+
+	m.use[m.uses++] = mix_use { op, uint8_t(count), uint8_t(chain) };
+}
+
+static mix mix_of(
+	char const* const name,
+	size_t const wires,
+	size_t const ways,
+	std::initializer_list< mix_use > const use) {
+
+	mix m = { name, wires, ways, 0, { } };
+	for (mix_use const& u : use)
+		mix_add(m, u.op, u.count, u.chain);
+	return m;
+}
+
+#if __aarch64__
+// op mix of a generated pruner, from its plan: each stage gathers its two operands by a tbl of one or two registers, or
+// takes the min vector as is, and compares them; the stage's chain is its longer operand plus the compare
+static mix mix_of(
+	char const* const name,
+	sortnet_plan const& plan,
+	size_t const ways) {
+
+	bool const q = sortnet_form_q == plan.half;
+	size_t const regs = plan.wires / 16;
+
+	mix m = { name, plan.wires, ways, 0, { } };
+	mix_add(m, op_cmhs_q, regs, 1);
+	mix_add(m, op_orr_q, regs, 1);
+	mix_add(m, op_addv_q, regs, 0);
+
+	for (size_t s = 0; s < plan.stages; ++s) {
+		uint8_t const src[] = { plan.src_a[s], plan.src_b[s] };
+		bool chained = false;
+
+		for (uint8_t const sr : src) {
+			if (sortnet_src_as_is == sr)
+				continue;
+
+			// the d-form takes the risen index, and both halves of the stage before, as one 16-lane table
+			uint8_t const op = q ?
+				(sortnet_src_both == sr || (sortnet_src_input == sr && 1 < regs) ? op_tbl2_q : op_tbl1_q) : op_tbl1_d;
+			mix_add(m, op, 1, chained ? 0 : 1);
+			chained = true;
+		}
+		mix_add(m, q ? op_umin_q : op_umin_d, 1, 1);
+		mix_add(m, q ? op_umax_q : op_umax_d, 1, 0);
+	}
+
+	// the sorted index in order, then the batch sampled by it
+	mix_add(m, q ? op_tbl2_q : op_tbl1_q, regs, 1);
+	mix_add(m, 1 < regs ? op_tbl2_q : op_tbl1_q, regs, 1);
+	return m;
+}
+
+static mix const* mixes(size_t& count) {
+	static mix const m[] = {
+		// testee04: the risen index, the 10 layers of the 16-element network, the batch sampled
+		mix_of("testee04", 16, 1, {
+			{ op_cmhs_q,  1,  1 },
+			{ op_orr_q,   1,  1 },
+			{ op_tbl1_q,  3,  2 },
+			{ op_tbl2_q, 19, 10 },
+			{ op_umin_q, 10, 10 },
+			{ op_umax_q, 10,  0 },
+			{ op_addv_q,  1,  0 } }),
+		// testee05: the same in d-form
+		mix_of("testee05", 16, 1, {
+			{ op_cmhs_q,  1,  1 },
+			{ op_orr_q,   1,  1 },
+			{ op_tbl1_d, 20, 10 },
+			{ op_umin_d, 10, 10 },
+			{ op_umax_d, 10,  0 },
+			{ op_tbl1_q,  2,  2 },
+			{ op_addv_q,  1,  0 } }),
+		// testee06: the counts of the 4-lane pieces, the risen index, the four 4-element networks, the batch sampled
+		mix_of("testee06", 16, 1, {
+			{ op_cmhs_q,  1,  1 },
+			{ op_add_q,   1,  0 },
+			{ op_addp_q,  2,  0 },
+			{ op_orr_q,   1,  1 },
+			{ op_uzp1_q,  1,  1 },
+			{ op_uzp2_q,  1,  0 },
+			{ op_umin_d,  3,  1 },
+			{ op_umax_d,  3,  2 },
+			{ op_trn1_d,  1,  1 },
+			{ op_trn2_d,  1,  0 },
+			{ op_rev16_d, 2,  2 },
+			{ op_zip1_h,  1,  1 },
+			{ op_tbl1_q,  1,  1 } }),
+		// testee07: the same over two batches in q-form, with the counts in d-form
+		mix_of("testee07", 32, 1, {
+			{ op_cmhs_q,  2,  1 },
+			{ op_add_q,   2,  0 },
+			{ op_addp_d,  4,  0 },
+			{ op_orr_q,   2,  1 },
+			{ op_uzp1_q,  1,  1 },
+			{ op_uzp2_q,  1,  0 },
+			{ op_umin_q,  3,  1 },
+			{ op_umax_q,  3,  2 },
+			{ op_trn1_q,  1,  1 },
+			{ op_trn2_q,  1,  0 },
+			{ op_rev16_q, 2,  2 },
+			{ op_zip1_h,  1,  1 },
+			{ op_zip2_h,  1,  0 },
+			{ op_tbl1_q,  2,  1 } }),
+		mix_of("testee14", sortnet_plan14, 1),
+		mix_of("testee15", sortnet_plan15, 1),
+		mix_of("testee16", sortnet_plan16, 1),
+		mix_of("testee17", sortnet_plan14, 2),
+		mix_of("testee18", sortnet_plan14, 4),
+		mix_of("testee19", sortnet_plan14, 8)
+	};
+
+	count = sizeof(m) / sizeof(m[0]);
+	return m;
+}
+
+#elif __x86_64__
+// op mix of a generated pruner, from its plan: each stage gathers its two operands by a pshufb, of the min and max
+// vectors unpacked into one -- once for both operands -- when it takes from both, or takes the min vector as is, and
+// compares them; the stage's chain is its longer operand plus the compare
+static mix mix_of(
+	char const* const name,
+	sortnet_plan const& plan,
+	size_t const ways) {
+
+	mix m = { name, plan.wires, ways, 0, { } };
+	mix_add(m, op_pcmpgtb, 1, 1);
+	mix_add(m, op_pcmpeqb, 1, 1);
+	mix_add(m, op_por, 1, 1);
+
+	for (size_t s = 0; s < plan.stages; ++s) {
+		uint8_t const src[] = { plan.src_a[s], plan.src_b[s] };
+		bool const both = sortnet_src_both == src[0] || sortnet_src_both == src[1];
+		size_t const shuf = (sortnet_src_as_is != src[0]) + (sortnet_src_as_is != src[1]);
+
+		mix_add(m, op_punpcklqdq, both ? 1 : 0, both ? 1 : 0);
+		mix_add(m, op_pshufb, shuf, shuf ? 1 : 0);
+		mix_add(m, op_pminub, 1, 1);
+		mix_add(m, op_pmaxub, 1, 0);
+	}
+
+	// the sorted index in order, then the batch sampled by it and stored a run at a time
+	mix_add(m, op_punpcklqdq, 1, 1);
+	mix_add(m, op_pshufb, 2, 2);
+	mix_add(m, op_pmovmskb, 1, 0);
+	mix_add(m, op_pshufd, 4 == plan.run ? 3 : 0, 0);
+	mix_add(m, op_punpcklqdq, 8 == plan.run ? 1 : 0, 0);
+	mix_add(m, op_popcnt, 16 / plan.run, 0);
+	return m;
+}
+
+static mix const* mixes(size_t& count) {
+	static std::initializer_list< mix_use > const mix07 = {
+		{ op_vpcmpgtb,     1, 1 },
+		{ op_vpor,         1, 1 },
+		{ op_vpshufb,      7, 5 },
+		{ op_vpminub,      3, 3 },
+		{ op_vpmaxub,      3, 0 },
+		{ op_vpunpcklqdq,  2, 2 },
+		{ op_vextracti128, 1, 0 },
+		{ op_vpextrq,      2, 0 },
+		{ op_vpmovmskb,    1, 0 },
+		{ op_popcnt,       8, 0 } };
+
+	static mix const m[] = {
+		// testee04: the risen index, the four 4-element networks, the batch sampled and stored 4 chars at a time
+		mix_of("testee04", 16, 1, {
+			{ op_pcmpgtb,    1, 1 },
+			{ op_pcmpeqb,    1, 1 },
+			{ op_por,        1, 1 },
+			{ op_pshufb,     7, 5 },
+			{ op_pminub,     3, 3 },
+			{ op_pmaxub,     3, 0 },
+			{ op_punpcklqdq, 2, 2 },
+			{ op_pshufd,     3, 0 },
+			{ op_pmovmskb,   1, 0 },
+			{ op_popcnt,     4, 0 } }),
+		mix_of("testee14", sortnet_plan14, 1),
+		mix_of("testee15", sortnet_plan15, 1),
+		mix_of("testee17", sortnet_plan15, 2),
+		mix_of("testee18", sortnet_plan15, 4),
+		mix_of("testee19", sortnet_plan15, 8),
+		// testee07: testee04 on both 128-bit lanes of a ymm, the batch fetched by gpr extracts and stored 4 chars at a
+		// time; testee09 is two of those in lockstep
+		mix_of("testee07", 32, 1, mix07),
+		mix_of("testee09", 32, 2, mix07)
+	};
+
+	count = sizeof(m) / sizeof(m[0]);
+	return m;
+}
 
 #endif
+struct lattest_conf {
+	size_t reps;
+	size_t runs;
+	double mhz;
+	bool has_perf;
+	perfcnt_group group;
+};
+
+// best of runs of a runner, per op
+static double lattest_time(
+	lattest_conf const& conf,
+	void (* const fn)(size_t reps)) {
+
+	double best = 0.0;
+	fn(conf.reps / 16);
+
+	for (size_t r = 0; r < conf.runs; ++r) {
+		uint64_t const t0 = perfcnt_ns();
+		perfcnt_start(conf.group);
+		fn(conf.reps);
+		perfcnt_stop(conf.group);
+		uint64_t const t1 = perfcnt_ns();
+
+		uint64_t value[PERFCNT_COUNT];
+		perfcnt_read(conf.group, value);
+
+		double const ops = double(conf.reps) * 8;
+		double const t = conf.has_perf ? double(value[PERFCNT_CYCLES]) / ops :
+			0.0 != conf.mhz ? double(t1 - t0) * conf.mhz * 1e-3 / ops : double(t1 - t0) / ops;
+
+		if (0 == r || t < best)
+			best = t;
+	}
+	return best;
+}
+
+int main(int argc, char** argv) {
+	lattest_conf conf;
+	conf.reps = size_t(1) << 22;
+	conf.runs = 5;
+	conf.mhz = 0.0;
+
+	int opt;
+	while (-1 != (opt = getopt(argc, argv, "c:r:n:"))) {
+		switch (opt) {
+		case 'c':
+			conf.mhz = strtod(optarg, 0);
+			break;
+		case 'r':
+			conf.reps = strtoul(optarg, 0, 10);
+			break;
+		case 'n':
+			conf.runs = strtoul(optarg, 0, 10);
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-c MHz] [-r reps] [-n runs]\n", argv[0]);
+			return -1;
+		}
+	}
+
+	if (0 == conf.reps || 0 == conf.runs) {
+		fprintf(stderr, "error: reps and runs must be positive\n");
+		return -1;
+	}
+
+#if __x86_64__
+	if (!cpu_has_ssse3_popcnt()) {
+		fprintf(stderr, "error: ssse3 and popcnt required\n");
+		return -1;
+	}
+
 #endif
-    }
+	conf.has_perf = perfcnt_open(conf.group);
+	char const* const unit = conf.has_perf || 0.0 != conf.mhz ? "clk" : "ns";
+
+	op_time time[op_count];
+	printf("%-12s %8s %8s  (%s)\n", "op", "lat", "rtput", unit);
+
+	for (size_t i = 0; i < op_count; ++i) {
+		if (!op_table[i].supported()) {
+			printf("%-12s %8s %8s\n", op_table[i].name, "-", "-");
+			continue;
+		}
+
+		time[i].lat = lattest_time(conf, op_table[i].chain);
+		time[i].rtput = lattest_time(conf, op_table[i].coissue);
+		printf("%-12s %8.3f %8.3f\n", op_table[i].name, time[i].lat, time[i].rtput);
+	}
+
+	size_t count;
+	mix const* const m = mixes(count);
+	printf("\n%-12s %8s %8s %8s  (%s/char)\n", "pruner", "issue", "latency", "predict", unit);
+
+	for (size_t i = 0; i < count; ++i) {
+		double issue = 0.0;
+		double latency = 0.0;
+		bool supported = true;
+
+		for (size_t j = 0; j < m[i].uses; ++j) {
+			issue += m[i].use[j].count * time[m[i].use[j].op].rtput;
+			latency += m[i].use[j].chain * time[m[i].use[j].op].lat;
+			supported = supported && op_table[m[i].use[j].op].supported();
+		}
+
+		// the pruners of ops the cpu lacks are left out, as those ops are
+		if (!supported)
+			continue;
+
+		issue /= m[i].wires;
+		latency /= m[i].wires * m[i].ways;
+		printf("%-12s %8.3f %8.3f %8.3f\n", m[i].name, issue, latency, issue > latency ? issue : latency);
+	}
 
-    return 0;
+	perfcnt_close(conf.group);
+	return 0;
 }
@@ -1,14 +1,5 @@
 #!/bin/bash
 
-if [ -z `which time` ]; then
-	echo "error: time not found"
-	exit 255
-fi
-if [ -z `which bc` ]; then
-	echo "error: bc not found"
-	exit 254
-fi
-
 if [[ $# -eq 1 ]]; then
 	CLOCK=$1
 else
@@ -53,23 +44,12 @@ elif [[ ${HOSTTYPE} == "x86_64" ]]; then
 		echo "error: $CC not found"
 		exit 253
 	fi
-	CFLAGS+=(
-		-mssse3
-	)
 else
 	echo "error: unsupported host type"
 	exit 251
 fi
 
-${CC} ${CFLAGS[@]} lattest.cpp -o lattest_nocoissue
-${CC} ${CFLAGS[@]} lattest.cpp -o lattest_coissue -DCOISSUE
+${CC} ${CFLAGS[@]} lattest.cpp -o lattest || exit 249
 
-if [[ `uname` == "Darwin" ]]; then
-	TIME_A=$(zsh -c "TIMEFMT=%U; time ./lattest_nocoissue" 2>&1); TIME_A=${TIME_A%?} # strip trailing 's'
-	TIME_B=$(zsh -c "TIMEFMT=%U; time ./lattest_coissue" 2>&1); TIME_B=${TIME_B%?} # strip trailing 's'
-else
-	TIME_A=$(`which time` -f %e ./lattest_nocoissue 2>&1)
-	TIME_B=$(`which time` -f %e ./lattest_coissue 2>&1)
-fi
-echo "scale=4; ${TIME_A} * ${CLOCK} * 10^6 / (2 * 10^9 * 16)" | bc
-echo "scale=4; ${TIME_B} * ${CLOCK} * 10^6 / (2 * 10^9 * 16)" | bc
+# the clock is only used when the cycle counter is unavailable
+./lattest -c ${CLOCK}
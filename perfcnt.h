@@ -0,0 +1,135 @@
+// hardware performance counters -- a group of user-space counters via perf_event_open, read in one go
+#ifndef PERFCNT_H_
+#define PERFCNT_H_
+
+#if __linux__
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+#endif
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+enum {
+	PERFCNT_CYCLES,
+	PERFCNT_INSTRUCTIONS,
+	PERFCNT_BRANCH_MISSES,
+	PERFCNT_L1D_MISSES, // l1d read misses
+
+	PERFCNT_COUNT
+};
+
+struct perfcnt_group {
+	int fd[PERFCNT_COUNT]; // fd[0] is the group leader; -1 when unavailable
+};
+
+// open a group of counters for the calling thread, on any cpu; false if the leader could not be opened, e.g. for
+// lack of a pmu or of perf_event_paranoid permissions -- followers that fail to open simply read as zero
+inline bool perfcnt_open(perfcnt_group& group) {
+	for (size_t i = 0; i < PERFCNT_COUNT; ++i)
+		group.fd[i] = -1;
+
+#if __linux__
+	static uint32_t const type[PERFCNT_COUNT] = {
+		PERF_TYPE_HARDWARE,
+		PERF_TYPE_HARDWARE,
+		PERF_TYPE_HARDWARE,
+		PERF_TYPE_HW_CACHE,
+	};
+	static uint64_t const config[PERFCNT_COUNT] = {
+		PERF_COUNT_HW_CPU_CYCLES,
+		PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_BRANCH_MISSES,
+		PERF_COUNT_HW_CACHE_L1D | PERF_COUNT_HW_CACHE_OP_READ << 8 | PERF_COUNT_HW_CACHE_RESULT_MISS << 16,
+	};
+
+	for (size_t i = 0; i < PERFCNT_COUNT; ++i) {
+		perf_event_attr attr;
+		memset(&attr, 0, sizeof(attr));
+		attr.size = sizeof(attr);
+		attr.type = type[i];
+		attr.config = config[i];
+		attr.disabled = 0 == i;
+		attr.exclude_kernel = 1;
+		attr.exclude_hv = 1;
+		attr.read_format = PERF_FORMAT_GROUP;
+
+		group.fd[i] = syscall(SYS_perf_event_open, &attr, 0, -1, 0 == i ? -1 : group.fd[0], 0);
+
+		if (-1 == group.fd[0])
+			return false;
+	}
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+inline void perfcnt_close(perfcnt_group& group) {
+#if __linux__
+	for (size_t i = PERFCNT_COUNT; i-- > 0; )
+		if (-1 != group.fd[i])
+			close(group.fd[i]);
+
+#endif
+	for (size_t i = 0; i < PERFCNT_COUNT; ++i)
+		group.fd[i] = -1;
+}
+
+inline void perfcnt_start(perfcnt_group const& group) {
+#if __linux__
+	if (-1 == group.fd[0])
+		return;
+
+	ioctl(group.fd[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+	ioctl(group.fd[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+inline void perfcnt_stop(perfcnt_group const& group) {
+#if __linux__
+	if (-1 == group.fd[0])
+		return;
+
+	ioctl(group.fd[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+// read all counters of the group; members that failed to open read as zero
+inline bool perfcnt_read(
+	perfcnt_group const& group,
+	uint64_t (&value)[PERFCNT_COUNT]) {
+
+	for (size_t i = 0; i < PERFCNT_COUNT; ++i)
+		value[i] = 0;
+
+#if __linux__
+	if (-1 == group.fd[0])
+		return false;
+
+	uint64_t buffer[1 + PERFCNT_COUNT];
+	if (read(group.fd[0], buffer, sizeof(buffer)) < ssize_t(sizeof(buffer[0])))
+		return false;
+
+	for (size_t i = 0, j = 0; i < PERFCNT_COUNT && j < buffer[0]; ++i)
+		if (-1 != group.fd[i])
+			value[i] = buffer[1 + j++];
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+// monotonic wall clock, in ns
+inline uint64_t perfcnt_ns() {
+	timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return uint64_t(t.tv_sec) * 1000000000 + uint64_t(t.tv_nsec);
+}
+
+#endif // PERFCNT_H_
@@ -0,0 +1,3015 @@
+// pruning of blanks from an ascii stream -- batch pruners and bulk driver
+#ifndef PRUNE_H_
+#define PRUNE_H_
+
+#if defined(__ARM_FEATURE_SVE)
+	#include <arm_sve.h>
+#endif
+#if __aarch64__
+	#include <arm_neon.h>
+	#if __linux__
+		#include <sys/auxv.h>
+		#include <asm/hwcap.h>
+	#endif
+#elif __x86_64__ || __i386__
+	#include <immintrin.h>
+	#include <cpuid.h>
+
+	// amd64 pruners are built for their isa regardless of the codegen flags, and picked at runtime
+	#define TARGET_SSSE3        __attribute__ ((target("ssse3")))
+	#define TARGET_SSSE3_POPCNT __attribute__ ((target("ssse3,popcnt")))
+	#define TARGET_AVX2         __attribute__ ((target("avx2,popcnt")))
+#endif
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "sortnet.h"
+#if PRUNE_STATS
+	#include "prune_stats.h"
+#endif
+
+// set of chars to prune, as an arbitrary 256-bit byte set, kept as nibble lookup tables for the vector classifiers:
+// char c is in the set if bit (c >> 4 & 7) of row[c >> 7][c & 15] is set -- the low nibble picks a row, the high nibble
+// a bit in it; a set without chars above 0x7f needs just the one row lookup and the one bit lookup; build sets by the
+// constexpr functions below, e.g.
+//
+//   static constexpr blank_set blank_keep_lf = blank_set_minus(blank_ascii, blank_set_of("\n"));
+//   prune< blank_keep_lf >(in, len, out);
+enum {
+	blank_cmp_lookup,  // by the tables
+	blank_cmp_native,  // c <= ' ' as the original pruners compare: signed on amd64, unsigned on arm64
+	blank_cmp_unsigned // c <= ' ', on all archs
+};
+
+struct blank_set {
+	uint8_t row[2][16]; // [0] for chars 0x00 - 0x7f, [1] for 0x80 - 0xff
+	uint8_t has[256];   // 1 for members; the scalar lookup
+	bool high;          // any of 0x80 - 0xff in the set
+	bool empty;
+	uint8_t pad;        // a member of the set, for padding batches, if not empty; ' ' if a member
+	uint8_t cmp;        // a compare that classifies the set as well as the tables, if any
+	bool utf8;          // the utf-8 sequences of unicode spaces are blanks too; see utf8_canon
+};
+
+// bit (h & 7) for high nibble h
+static uint8_t const blank_set_bits[16] __attribute__ ((aligned(16))) = {
+	1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128
+};
+
+constexpr bool blank_set_has(
+	blank_set const& set,
+	uint8_t const c) {
+
+	return 0 != (set.row[c >> 7][c & 15] >> (c >> 4 & 7) & 1);
+}
+
+// fill in the summary fields after the tables
+constexpr blank_set blank_set_finish(blank_set set) {
+	set.high = false;
+	set.empty = true;
+	set.pad = 0;
+	set.cmp = blank_cmp_lookup;
+	set.utf8 = false;
+
+	for (int c = 255; c >= 0; --c) {
+		set.has[c] = blank_set_has(set, uint8_t(c)) ? 1 : 0;
+		if (!set.has[c])
+			continue;
+
+		set.high = set.high || c > 0x7f;
+		set.empty = false;
+		set.pad = uint8_t(c);
+	}
+
+	if (blank_set_has(set, ' '))
+		set.pad = ' ';
+
+	return set;
+}
+
+constexpr blank_set blank_set_put(
+	blank_set set,
+	uint8_t const c) {
+
+	set.row[c >> 7][c & 15] |= uint8_t(1 << (c >> 4 & 7));
+	return set;
+}
+
+// chars first through last, inclusive
+constexpr blank_set blank_set_range(
+	uint8_t const first,
+	uint8_t const last) {
+
+	blank_set set = {};
+	for (int c = first; c <= last; ++c)
+		set = blank_set_put(set, uint8_t(c));
+
+	return blank_set_finish(set);
+}
+
+// all chars of the string literal, embedded nuls included
+template < size_t N >
+constexpr blank_set blank_set_of(char const (&chars)[N]) {
+	blank_set set = {};
+	for (size_t i = 0; i + 1 < N; ++i)
+		set = blank_set_put(set, uint8_t(chars[i]));
+
+	return blank_set_finish(set);
+}
+
+constexpr blank_set blank_set_union(
+	blank_set const& a,
+	blank_set const& b) {
+
+	blank_set set = {};
+	for (size_t i = 0; i < 2; ++i)
+		for (size_t j = 0; j < 16; ++j)
+			set.row[i][j] = uint8_t(a.row[i][j] | b.row[i][j]);
+
+	return blank_set_finish(set);
+}
+
+constexpr blank_set blank_set_minus(
+	blank_set const& a,
+	blank_set const& b) {
+
+	blank_set set = {};
+	for (size_t i = 0; i < 2; ++i)
+		for (size_t j = 0; j < 16; ++j)
+			set.row[i][j] = uint8_t(a.row[i][j] & ~b.row[i][j]);
+
+	return blank_set_finish(set);
+}
+
+// utf-8-safe version of a set: its chars above 0x7f are dropped, as those are parts of multi-char sequences, while the
+// sequences of the unicode spaces U+00A0, U+2000 - U+200B and U+3000 become blanks; meant for sets with members
+// below 0x80, whose pad those sequences are replaced by -- see utf8_canon
+constexpr blank_set blank_set_utf8(blank_set const& base) {
+	blank_set set = base.high ? blank_set_minus(base, blank_set_range(0x80, 0xff)) : base;
+	set.utf8 = true;
+	return set;
+}
+
+constexpr blank_set blank_set_cmp(
+	blank_set set,
+	uint8_t const cmp) {
+
+	set.cmp = cmp;
+	return set;
+}
+
+// the blanks of the original pruners -- all chars up to ' ', and on amd64, whose pruners compare signed, all chars
+// above 0x7f; the default set
+#if __x86_64__ || __i386__
+constexpr blank_set blank_space = blank_set_cmp(
+	blank_set_union(blank_set_range(0, ' '), blank_set_range(0x80, 0xff)), blank_cmp_native);
+#else
+constexpr blank_set blank_space = blank_set_cmp(blank_set_range(0, ' '), blank_cmp_native);
+#endif
+
+// all chars up to ' ' on all archs, keeping all chars above 0x7f, so utf-8 text passes intact
+constexpr blank_set blank_ascii = blank_set_cmp(blank_set_range(0, ' '), blank_cmp_unsigned);
+
+// blank_ascii plus the unicode spaces
+constexpr blank_set blank_unicode = blank_set_utf8(blank_ascii);
+
+template < blank_set const& set >
+inline bool is_blank(uint8_t const c) {
+	if (set.cmp == blank_cmp_native)
+#if __x86_64__ || __i386__
+		return int8_t(c) <= ' ';
+#else
+		return c <= ' ';
+#endif
+	if (set.cmp == blank_cmp_unsigned)
+		return c <= ' ';
+
+	return set.has[c];
+}
+
+#if __aarch64__
+// 0xff for the lanes of blanks
+template < blank_set const& set >
+inline uint8x16_t blank_mask(uint8x16_t const vin) {
+	if (set.cmp != blank_cmp_lookup)
+		return vcleq_u8(vin, vdupq_n_u8(' '));
+
+	// tbl zeroes the lanes of out-of-range indices, so masking bits 4 - 6 off leaves the upper chars out of row 0
+	uint8x16_t const index = vandq_u8(vin, vdupq_n_u8(0x8f));
+	uint8x16_t row = vqtbl1q_u8(vld1q_u8(set.row[0]), index);
+	if (set.high)
+		row = vorrq_u8(row, vqtbl1q_u8(vld1q_u8(set.row[1]), veorq_u8(index, vdupq_n_u8(0x80))));
+
+	uint8x16_t const bit = vqtbl1q_u8(vld1q_u8(blank_set_bits), vshrq_n_u8(vin, 4));
+	return vtstq_u8(row, bit);
+}
+
+#if defined(__ARM_FEATURE_SVE)
+// the non-blanks among the chars active under pr
+template < blank_set const& set >
+inline svbool_t nonblank_pred(
+	svbool_t const pr,
+	svuint8_t const vin) {
+
+	if (set.cmp != blank_cmp_lookup)
+		return svcmpgt_n_u8(pr, vin, ' ');
+
+	// the tables are replicated across all quadwords, so any low nibble indexes them
+	svuint8_t const lo = svand_n_u8_x(pr, vin, 0x0f);
+	svuint8_t const row0 = svtbl_u8(svld1rq_u8(svptrue_b8(), set.row[0]), lo);
+	svuint8_t const row1 = set.high ? svtbl_u8(svld1rq_u8(svptrue_b8(), set.row[1]), lo) : svdup_n_u8(0);
+	svuint8_t const row = svsel_u8(svcmplt_n_u8(pr, vin, 0x80), row0, row1);
+
+	svuint8_t const bit = svtbl_u8(svld1rq_u8(svptrue_b8(), blank_set_bits), svlsr_n_u8_x(pr, vin, 4));
+	return svcmpeq_n_u8(pr, svand_u8_x(pr, row, bit), 0);
+}
+
+#endif
+#elif __x86_64__ || __i386__
+// 0xff for the lanes of blanks, for the sets classified by a compare
+template < blank_set const& set >
+inline __m128i blank_mask_sse2(__m128i const vin) {
+	if (set.cmp == blank_cmp_native)
+		return _mm_cmplt_epi8(vin, _mm_set1_epi8(' ' + 1));
+
+	return _mm_cmpeq_epi8(_mm_min_epu8(vin, _mm_set1_epi8(' ')), vin);
+}
+
+// 0xff for the lanes of blanks
+template < blank_set const& set >
+TARGET_SSSE3 inline __m128i blank_mask(__m128i const vin) {
+	if (set.cmp != blank_cmp_lookup)
+		return blank_mask_sse2< set >(vin);
+
+	// pshufb looks at index bits 0 - 3 and zeroes the lanes of bit 7, which leaves the upper chars out of row 0
+	__m128i row = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast< __m128i const* >(set.row[0])), vin);
+	if (set.high)
+		row = _mm_or_si128(row, _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast< __m128i const* >(set.row[1])),
+			_mm_xor_si128(vin, _mm_set1_epi8(-128))));
+
+	__m128i const bit = _mm_shuffle_epi8(_mm_load_si128(reinterpret_cast< __m128i const* >(blank_set_bits)),
+		_mm_and_si128(_mm_srli_epi16(vin, 4), _mm_set1_epi8(0x0f)));
+	return _mm_cmpeq_epi8(_mm_and_si128(row, bit), bit);
+}
+
+#if __x86_64__
+template < blank_set const& set >
+TARGET_AVX2 inline __m256i blank_mask(__m256i const vin) {
+	if (set.cmp == blank_cmp_native)
+		return _mm256_cmpgt_epi8(_mm256_set1_epi8(' ' + 1), vin);
+	if (set.cmp == blank_cmp_unsigned)
+		return _mm256_cmpeq_epi8(_mm256_min_epu8(vin, _mm256_set1_epi8(' ')), vin);
+
+	__m256i row = _mm256_shuffle_epi8(
+		_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast< __m128i const* >(set.row[0]))), vin);
+	if (set.high)
+		row = _mm256_or_si256(row, _mm256_shuffle_epi8(
+			_mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast< __m128i const* >(set.row[1]))),
+			_mm256_xor_si256(vin, _mm256_set1_epi8(-128))));
+
+	__m256i const bit = _mm256_shuffle_epi8(
+		_mm256_broadcastsi128_si256(_mm_load_si128(reinterpret_cast< __m128i const* >(blank_set_bits))),
+		_mm256_and_si256(_mm256_srli_epi16(vin, 4), _mm256_set1_epi8(0x0f)));
+	return _mm256_cmpeq_epi8(_mm256_and_si256(row, bit), bit);
+}
+
+#endif
+#endif
+// utf-8 canonicalization ahead of the pruners, for the sets of blank_set_utf8: every char of a unicode space sequence
+// is replaced by the set's pad, so the pruners drop it as any other blank; sequences are matched at their lead char,
+// looking 2 chars ahead, and the matches are carried 2 chars over to the next 16, so sequences straddling batches are
+// matched as well -- the state of that carry is utf8_state, per buffer
+#if __aarch64__
+struct utf8_state {
+	uint8x16_t s3;  // lanes of 3-char sequence leads in the previous 16 chars
+	uint8x16_t s23; // lanes of 2- and 3-char sequence leads, ditto
+};
+
+inline utf8_state utf8_init() {
+	utf8_state const st = { vdupq_n_u8(0), vdupq_n_u8(0) };
+	return st;
+}
+
+// canonicalize 16 chars given the 16 after them
+template < blank_set const& set >
+inline uint8x16_t utf8_canon16(
+	uint8x16_t const v,
+	uint8x16_t const next,
+	utf8_state& st) {
+
+	uint8x16_t const b1 = vextq_u8(v, next, 1);
+	uint8x16_t const b2 = vextq_u8(v, next, 2);
+
+	// c2 a0; e2 80 80 - 8b; e3 80 80
+	uint8x16_t const s2 = vandq_u8(vceqq_u8(v, vdupq_n_u8(0xc2)), vceqq_u8(b1, vdupq_n_u8(0xa0)));
+	uint8x16_t const s3 = vandq_u8(vceqq_u8(b1, vdupq_n_u8(0x80)), vorrq_u8(
+		vandq_u8(vceqq_u8(v, vdupq_n_u8(0xe2)), vcleq_u8(vsubq_u8(b2, vdupq_n_u8(0x80)), vdupq_n_u8(0x0b))),
+		vandq_u8(vceqq_u8(v, vdupq_n_u8(0xe3)), vceqq_u8(b2, vdupq_n_u8(0x80)))));
+	uint8x16_t const s23 = vorrq_u8(s2, s3);
+
+	uint8x16_t const mask = vorrq_u8(s23, vorrq_u8(vextq_u8(st.s23, s23, 15), vextq_u8(st.s3, s3, 14)));
+	st.s3 = s3;
+	st.s23 = s23;
+
+	return vbslq_u8(mask, vdupq_n_u8(set.pad), v);
+}
+
+#elif __x86_64__ || __i386__
+struct utf8_state {
+	__m128i s3;  // lanes of 3-char sequence leads in the previous 16 chars
+	__m128i s23; // lanes of 2- and 3-char sequence leads, ditto
+};
+
+inline utf8_state utf8_init() {
+	utf8_state const st = { _mm_setzero_si128(), _mm_setzero_si128() };
+	return st;
+}
+
+// palignr by sse2, so all pruners can use it
+template < int n >
+inline __m128i utf8_alignr(
+	__m128i const hi,
+	__m128i const lo) {
+
+	return _mm_or_si128(_mm_srli_si128(lo, n), _mm_slli_si128(hi, 16 - n));
+}
+
+// canonicalize 16 chars given the 16 after them
+template < blank_set const& set >
+inline __m128i utf8_canon16(
+	__m128i const v,
+	__m128i const next,
+	utf8_state& st) {
+
+	__m128i const b1 = utf8_alignr< 1 >(next, v);
+	__m128i const b2 = utf8_alignr< 2 >(next, v);
+
+	// c2 a0; e2 80 80 - 8b; e3 80 80 -- 0x80 - 0x8b are -128 through -117 signed
+	__m128i const s2 = _mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(char(0xc2))), _mm_cmpeq_epi8(b1, _mm_set1_epi8(char(0xa0))));
+	__m128i const s3 = _mm_and_si128(_mm_cmpeq_epi8(b1, _mm_set1_epi8(char(0x80))), _mm_or_si128(
+		_mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(char(0xe2))), _mm_cmplt_epi8(b2, _mm_set1_epi8(-116))),
+		_mm_and_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8(char(0xe3))), _mm_cmpeq_epi8(b2, _mm_set1_epi8(char(0x80))))));
+	__m128i const s23 = _mm_or_si128(s2, s3);
+
+	__m128i const mask = _mm_or_si128(s23, _mm_or_si128(utf8_alignr< 15 >(s23, st.s23), utf8_alignr< 14 >(s3, st.s3)));
+	st.s3 = s3;
+	st.s23 = s23;
+
+	return _mm_or_si128(_mm_andnot_si128(mask, v), _mm_and_si128(mask, _mm_set1_epi8(char(set.pad))));
+}
+
+#else
+struct utf8_state {
+	size_t left; // chars of a matched sequence yet to come
+};
+
+inline utf8_state utf8_init() {
+	utf8_state const st = { 0 };
+	return st;
+}
+
+#endif
+// canonicalize the first n chars at in into out, padding out to batch chars; avail is the count of chars at in, for
+// looking ahead
+template < size_t batch, blank_set const& set >
+inline void utf8_canon(
+	uint8_t const* const in,
+	size_t const n,
+	size_t const avail,
+	uint8_t* const out,
+	utf8_state& st) {
+
+	for (size_t j = 0; j < batch; j += 16) {
+		uint8_t v_pad[16], next_pad[16];
+		uint8_t const* v = in + j;
+		uint8_t const* next = in + j + 16;
+
+		if (j + 16 > n) {
+			memset(v_pad, set.pad, sizeof(v_pad));
+			if (j < n)
+				memcpy(v_pad, in + j, n - j);
+			v = v_pad;
+		}
+		if (j + 32 > avail) {
+			memset(next_pad, set.pad, sizeof(next_pad));
+			if (j + 16 < avail)
+				memcpy(next_pad, in + j + 16, avail - j - 16 < 16 ? avail - j - 16 : 16);
+			next = next_pad;
+		}
+
+#if __aarch64__
+		vst1q_u8(out + j, utf8_canon16< set >(vld1q_u8(v), vld1q_u8(next), st));
+
+#elif __x86_64__ || __i386__
+		_mm_storeu_si128(reinterpret_cast< __m128i* >(out + j), utf8_canon16< set >(
+			_mm_loadu_si128(reinterpret_cast< __m128i const* >(v)),
+			_mm_loadu_si128(reinterpret_cast< __m128i const* >(next)), st));
+
+#else
+		uint8_t c[16 + 2];
+		memcpy(c, v, 16);
+		memcpy(c + 16, next, 2);
+
+		for (size_t k = 0; k < 16; ++k) {
+			uint8_t const* const p = c + k;
+			size_t const lead =
+				p[0] == 0xc2 && p[1] == 0xa0 ? 2 :
+				p[0] == 0xe2 && p[1] == 0x80 && p[2] >= 0x80 && p[2] <= 0x8b ? 3 :
+				p[0] == 0xe3 && p[1] == 0x80 && p[2] == 0x80 ? 3 : 0;
+
+			st.left = lead > st.left ? lead : st.left;
+			out[j + k] = st.left ? set.pad : p[0];
+			st.left -= st.left ? 1 : 0;
+		}
+
+#endif
+	}
+}
+
+// fully-scalar version; good performance on both amd64 and arm64 above-entry-level parts;
+// particularly on cortex-a72 this does an IPC of 2.94 which is excellent! ryzen also
+// does an IPC above 4, which is remarkable
+template < blank_set const& set = blank_space >
+inline size_t testee00(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	size_t i = 0, pos = 0;
+	while (i < 16) {
+		const uint8_t c = input[i++];
+		output[pos] = c;
+		pos += (is_blank< set >(c) ? 0 : 1);
+	}
+	return pos;
+}
+
+#if __aarch64__
+// naive pruner, 16-batch; filter single blank from N input chars, followed by K optional trailing blanks, N + K = batch size
+// example: "1234 678  " -> "1234678" (N + K = 10)
+inline size_t testee01(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	uint8x16_t const vinput = vld1q_u8(input);
+	uint8x16_t prfsum = vcleq_u8(vinput, vdupq_n_u8(' '));
+
+	// pick one:
+	// before computing the prefix sum: count_of_blanks := vaddvq_u8(prfsum)
+	// after computing the prefix sum: count_of_blanks := prfsum[last_lane]
+	prfsum = vaddq_u8(prfsum, vextq_u8(vdupq_n_u8(0), prfsum, 16 - 1));
+	prfsum = vaddq_u8(prfsum, vextq_u8(vdupq_n_u8(0), prfsum, 16 - 2));
+	prfsum = vaddq_u8(prfsum, vextq_u8(vdupq_n_u8(0), prfsum, 16 - 4));
+	prfsum = vaddq_u8(prfsum, vextq_u8(vdupq_n_u8(0), prfsum, 16 - 8));
+
+	int8_t const bnum = vgetq_lane_u8(prfsum, 15);
+
+	uint8x16_t const index = vsubq_u8((uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 }, prfsum);
+	uint8x16_t const res = vqtbl1q_u8(vinput, index);
+
+	vst1q_u8(output, res);
+	return sizeof(uint8x16_t) + bnum;
+}
+
+// naive pruner, 32-batch; filter single blank from N input chars, followed by K optional trailing blanks, N + K = half batch size
+// example: "1234 678  " -> "1234678" (N + K = 10)
+inline size_t testee02(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	uint8x16_t const vinput0 = vld1q_u8(input);
+	uint8x16_t const vinput1 = vld1q_u8(input + sizeof(uint8x16_t));
+	uint8x16_t prfsum0 = vcleq_u8(vinput0, vdupq_n_u8(' '));
+	uint8x16_t prfsum1 = vcleq_u8(vinput1, vdupq_n_u8(' '));
+
+	// pick one:
+	// before computing the prefix sum: count_of_blanks := vaddvq_u8(prfsum)
+	// after computing the prefix sum: count_of_blanks := prfsum[last_lane]
+	prfsum0 = vaddq_u8(prfsum0, vextq_u8(vdupq_n_u8(0), prfsum0, 16 - 1));
+	prfsum1 = vaddq_u8(prfsum1, vextq_u8(vdupq_n_u8(0), prfsum1, 16 - 1));
+	prfsum0 = vaddq_u8(prfsum0, vextq_u8(vdupq_n_u8(0), prfsum0, 16 - 2));
+	prfsum1 = vaddq_u8(prfsum1, vextq_u8(vdupq_n_u8(0), prfsum1, 16 - 2));
+	prfsum0 = vaddq_u8(prfsum0, vextq_u8(vdupq_n_u8(0), prfsum0, 16 - 4));
+	prfsum1 = vaddq_u8(prfsum1, vextq_u8(vdupq_n_u8(0), prfsum1, 16 - 4));
+	prfsum0 = vaddq_u8(prfsum0, vextq_u8(vdupq_n_u8(0), prfsum0, 16 - 8));
+	prfsum1 = vaddq_u8(prfsum1, vextq_u8(vdupq_n_u8(0), prfsum1, 16 - 8));
+
+	int8_t const bnum0 = vgetq_lane_u8(prfsum0, 15);
+	int8_t const bnum1 = vgetq_lane_u8(prfsum1, 15);
+
+	uint8x16_t const index0 = vsubq_u8((uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 }, prfsum0);
+	uint8x16_t const index1 = vsubq_u8((uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 }, prfsum1);
+	uint8x16_t const res0 = vqtbl1q_u8(vinput0, index0);
+	uint8x16_t const res1 = vqtbl1q_u8(vinput1, index1);
+
+	vst1q_u8(output, res0);
+	vst1q_u8(output + sizeof(uint8x16_t) + bnum0, res1);
+	return sizeof(uint8x16_t) * 2 + bnum0 + bnum1;
+}
+
+#elif __x86_64__ || __i386__
+// naive pruner, 16-batch; filter single blank from N input chars, followed by K optional trailing blanks, N + K = batch size
+// example: "1234 678  " -> "1234678" (N + K = 10)
+TARGET_SSSE3 inline size_t testee01(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	__m128i const vinput = _mm_loadu_si128(reinterpret_cast< const __m128i* >(input));
+	__m128i prfsum = _mm_cmplt_epi8(vinput, _mm_set1_epi8(' ' + 1));
+
+	// pick one:
+	// before computing the prefix sum: count_of_blanks := _mm_popcnt_u32(_mm_movemask_epi8(prfsum))
+	// after computing the prefix sum: count_of_blanks := prfsum[last_lane]
+	prfsum = _mm_add_epi8(prfsum, _mm_slli_si128(prfsum, 1));
+	prfsum = _mm_add_epi8(prfsum, _mm_slli_si128(prfsum, 2));
+	prfsum = _mm_add_epi8(prfsum, _mm_slli_si128(prfsum, 4));
+	prfsum = _mm_add_epi8(prfsum, _mm_slli_si128(prfsum, 8));
+
+	int8_t const bnum = uint16_t(_mm_extract_epi16(prfsum, 7)) >> 8;
+
+	__m128i const index = _mm_sub_epi8(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), prfsum);
+	__m128i const res = _mm_shuffle_epi8(vinput, index);
+
+	_mm_storeu_si128(reinterpret_cast< __m128i* >(output), res);
+	return sizeof(__m128i) + bnum;
+}
+
+// naive pruner, 32-batch; filter single blank from N input chars, followed by K optional trailing blanks, N + K = half batch size
+// example: "1234 678  " -> "1234678" (N + K = 10)
+TARGET_SSSE3 inline size_t testee02(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	__m128i const vinput0 = _mm_loadu_si128(reinterpret_cast< const __m128i* >(input));
+	__m128i const vinput1 = _mm_loadu_si128(reinterpret_cast< const __m128i* >(input) + 1);
+	__m128i prfsum0 = _mm_cmplt_epi8(vinput0, _mm_set1_epi8(' ' + 1));
+	__m128i prfsum1 = _mm_cmplt_epi8(vinput1, _mm_set1_epi8(' ' + 1));
+
+	// pick one:
+	// before computing the prefix sum: count_of_blanks := _mm_popcnt_u32(_mm_movemask_epi8(prfsum))
+	// after computing the prefix sum: count_of_blanks := prfsum[last_lane]
+	prfsum0 = _mm_add_epi8(prfsum0, _mm_slli_si128(prfsum0, 1));
+	prfsum1 = _mm_add_epi8(prfsum1, _mm_slli_si128(prfsum1, 1));
+	prfsum0 = _mm_add_epi8(prfsum0, _mm_slli_si128(prfsum0, 2));
+	prfsum1 = _mm_add_epi8(prfsum1, _mm_slli_si128(prfsum1, 2));
+	prfsum0 = _mm_add_epi8(prfsum0, _mm_slli_si128(prfsum0, 4));
+	prfsum1 = _mm_add_epi8(prfsum1, _mm_slli_si128(prfsum1, 4));
+	prfsum0 = _mm_add_epi8(prfsum0, _mm_slli_si128(prfsum0, 8));
+	prfsum1 = _mm_add_epi8(prfsum1, _mm_slli_si128(prfsum1, 8));
+
+	int8_t const bnum0 = uint16_t(_mm_extract_epi16(prfsum0, 7)) >> 8;
+	int8_t const bnum1 = uint16_t(_mm_extract_epi16(prfsum1, 7)) >> 8;
+
+	__m128i const index0 = _mm_sub_epi8(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), prfsum0);
+	__m128i const index1 = _mm_sub_epi8(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), prfsum1);
+	__m128i const res0 = _mm_shuffle_epi8(vinput0, index0);
+	__m128i const res1 = _mm_shuffle_epi8(vinput1, index1);
+
+	_mm_storeu_si128(reinterpret_cast< __m128i* >(output), res0);
+	_mm_storeu_si128(reinterpret_cast< __m128i* >(output + sizeof(__m128i) + bnum0), res1);
+	return sizeof(__m128i) * 2 + bnum0 + bnum1;
+}
+
+// pruner semi, 16-batch; replace blanks with the next non-blank, cutting off trailing blanks from the batch
+// example: "1234 678  " -> "12346678"
+TARGET_SSSE3_POPCNT inline size_t testee03(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	__m128i const vin = _mm_loadu_si128(reinterpret_cast< const __m128i* >(input));
+
+	// discover non-blanks
+	__m128i const pos = _mm_cmpgt_epi8(vin, _mm_set1_epi8(' '));
+
+	// mark blanks as ones
+	__m128i const spc = _mm_andnot_si128(pos, _mm_set1_epi8(1));
+
+	// prefix-sum the blanks, right to left
+	__m128i prfsum = spc;
+	prfsum = _mm_add_epi8(prfsum, _mm_srli_si128(prfsum, 1));
+	prfsum = _mm_add_epi8(prfsum, _mm_srli_si128(prfsum, 2));
+	prfsum = _mm_add_epi8(prfsum, _mm_srli_si128(prfsum, 4));
+	prfsum = _mm_add_epi8(prfsum, _mm_srli_si128(prfsum, 8));
+
+	// isolate sequences of blanks and count their individual lengths, right to left, using a prefix max and the above prefix sum
+	__m128i prfmax = _mm_and_si128(pos, prfsum);
+	prfmax = _mm_max_epu8(prfmax, _mm_srli_si128(prfmax, 1));
+	prfmax = _mm_max_epu8(prfmax, _mm_srli_si128(prfmax, 2));
+	prfmax = _mm_max_epu8(prfmax, _mm_srli_si128(prfmax, 4));
+	prfmax = _mm_max_epu8(prfmax, _mm_srli_si128(prfmax, 8));
+	prfmax = _mm_sub_epi8(prfsum, prfmax);
+
+	// add blank counts to a sequential index to get non-blanks index
+	__m128i const index = _mm_add_epi8(_mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15), prfmax);
+
+	// cap trailing out-of-bounds in the index
+	__m128i const indey = _mm_or_si128(index, _mm_cmpgt_epi8(index, _mm_set1_epi8(15)));
+
+	// use the index to fetch all non-blanks from the dictionary
+	__m128i const res = _mm_shuffle_epi8(vin, indey);
+
+	_mm_storeu_si128(reinterpret_cast< __m128i* >(output), res);
+	return sizeof(__m128i) - _mm_popcnt_u32(_mm_movemask_epi8(indey));
+}
+
+#endif
+// From here on start the proper pruners. They all implement the following idea:
+//
+//  1. Get the unperturbed index of all elements of a vector, e.g. { 0, 1, 2, 3, 4, 5, 6, 7 } for an 8-element vector
+//  2. For all blank lanes in the input ascii vector, raise the corresponding lanes in the index vector to MAX_INT, e.g. { 0, 1, 0xff, 3, 0xff, 0xff, 6, 7 }
+//  3. Sort the resulting index vector in ascending order, e.g. { 0, 1, 3, 6, 7, 0xff, 0xff, 0xff }
+//
+// This is the desired index by which to sample the original input vector. That's all.
+
+#if __aarch64__
+// the sorting network of testee04: sort a risen index, i.e. one whose blank lanes have their top bit set, so that the
+// original indices of all non-blanks come first, in order
+inline uint8x16_t sort_index04(uint8x16_t const risen) {
+
+	// 16-element sorting network: http://pages.ripco.net/~jgamble/nw.html -- 'Best version'
+	// stage 0
+	uint8x16_t const st0a = vqtbl1q_u8(risen, (uint8x16_t) { 0, 2, 4, 6, 8, 10, 12, 14, });
+	uint8x16_t const st0b = vqtbl1q_u8(risen, (uint8x16_t) { 1, 3, 5, 7, 9, 11, 13, 15, });
+	uint8x16_t const st0min = vminq_u8(st0a, st0b); //  0,  2,  4,  6,  8, 10, 12, 14
+	uint8x16_t const st0max = vmaxq_u8(st0a, st0b); //  1,  3,  5,  7,  9, 11, 13, 15
+
+	// stage 1
+	uint8x16x2_t const st0 = { { st0min, st0max } };
+	uint8x16_t const st1a = vqtbl2q_u8(st0, (uint8x16_t) { 0, 2, 4, 6, 16, 18, 20, 22, });
+	uint8x16_t const st1b = vqtbl2q_u8(st0, (uint8x16_t) { 1, 3, 5, 7, 17, 19, 21, 23, });
+	uint8x16_t const st1min = vminq_u8(st1a, st1b); //  0,  4,  8, 12,  1,  5,  9, 13
+	uint8x16_t const st1max = vmaxq_u8(st1a, st1b); //  2,  6, 10, 14,  3,  7, 11, 15
+
+	// stage 2
+	uint8x16x2_t const st1 = { { st1min, st1max } };
+	uint8x16_t const st2a = vqtbl2q_u8(st1, (uint8x16_t) { 0, 2, 4, 6, 16, 18, 20, 22, });
+	uint8x16_t const st2b = vqtbl2q_u8(st1, (uint8x16_t) { 1, 3, 5, 7, 17, 19, 21, 23, });
+	uint8x16_t const st2min = vminq_u8(st2a, st2b); //  0,  8,  1,  9,  2, 10,  3, 11
+	uint8x16_t const st2max = vmaxq_u8(st2a, st2b); //  4, 12,  5, 13,  6, 14,  7, 15
+
+	// stage 3
+	uint8x16x2_t const st2 = { { st2min, st2max } };
+	uint8x16_t const st3a = vqtbl2q_u8(st2, (uint8x16_t) { 0, 2, 4, 6, 16, 18, 20, 22, });
+	uint8x16_t const st3b = vqtbl2q_u8(st2, (uint8x16_t) { 1, 3, 5, 7, 17, 19, 21, 23, });
+	uint8x16_t const st3min = vminq_u8(st3a, st3b); // 0, 1,  2,  3,  4,  5,  6,  7
+	uint8x16_t const st3max = vmaxq_u8(st3a, st3b); // 8, 9, 10, 11, 12, 13, 14, 15
+
+	// from here on some indices are already done -- freeze them, by keeping them in deterministic positions
+
+	// stage 4; indices done so far: 0, 15
+	uint8x16x2_t const st3 = { { st3min, st3max } };
+	uint8x16_t const st4a = vqtbl2q_u8(st3, (uint8x16_t) {  0,  5,  6,  3, 21,  7, 1,  4, });
+	uint8x16_t const st4b = vqtbl2q_u8(st3, (uint8x16_t) { 23, 18, 17, 20, 22, 19, 2, 16, });
+	uint8x16_t const st4min = vminq_u8(st4a, st4b); // [ 0],  5,  6,  3, 13,  7,  1,  4
+	uint8x16_t const st4max = vmaxq_u8(st4a, st4b); // [15], 10,  9, 12, 14, 11,  2,  8
+
+	// stage 5; done so far: 0, 15; temp frozen: 3, 12
+	uint8x16x2_t const st4 = { { st4min, st4max } };
+	uint8x16_t const st5a = vqtbl2q_u8(st4, (uint8x16_t) {  0,  3, 6, 5, 22, 21, 1, 18, });
+	uint8x16_t const st5b = vqtbl2q_u8(st4, (uint8x16_t) { 16, 19, 7, 4, 23, 20, 2, 17, });
+	uint8x16_t const st5min = vminq_u8(st5a, st5b); // [ 0], [ 3], 1,  7, 2, 11, 5,  9
+	uint8x16_t const st5max = vmaxq_u8(st5a, st5b); // [15], [12], 4, 13, 8, 14, 6, 10
+
+	// stage 6; done so far: 0, 1, 14, 15; temp frozen: 5, 6, 9, 10
+	uint8x16x2_t const st5 = { { st5min, st5max } };
+	uint8x16_t const st6a = vqtbl2q_u8(st5, (uint8x16_t) {  0,  2,  4,  5,  1,  3,  6,  7, });
+	uint8x16_t const st6b = vqtbl2q_u8(st5, (uint8x16_t) { 16, 21, 18, 19, 20, 17, 22, 23, });
+	uint8x16_t const st6min = vminq_u8(st6a, st6b); // [ 0], [ 1], 2, 11, 3,  7, [5], [ 9]
+	uint8x16_t const st6max = vmaxq_u8(st6a, st6b); // [15], [14], 4, 13, 8, 12, [6], [10]
+
+	// stage 7; done so far: 0, 1, 2, 13, 14, 15; temp frozen: 4, 11
+	uint8x16x2_t const st6 = { { st6min, st6max } };
+	uint8x16_t const st7a = vqtbl2q_u8(st6, (uint8x16_t) {  0,  1,  2,  3, 22, 23, 4, 5, });
+	uint8x16_t const st7b = vqtbl2q_u8(st6, (uint8x16_t) { 16, 17, 18, 19, 20, 21, 6, 7, });
+	uint8x16_t const st7min = vminq_u8(st7a, st7b); // [ 0], [ 1], [2], [11], 6, 10, 3, 7
+	uint8x16_t const st7max = vmaxq_u8(st7a, st7b); // [15], [14], [4], [13], 8, 12, 5, 9
+
+	// stage 8; done so far: 0, 1, 2, 13, 14, 15
+	uint8x16x2_t const st7 = { { st7min, st7max } };
+	uint8x16_t const st8a = vqtbl2q_u8(st7, (uint8x16_t) {  0,  1,  2,  6, 22,  7, 23,  3, });
+	uint8x16_t const st8b = vqtbl2q_u8(st7, (uint8x16_t) { 16, 17, 19, 18,  4, 20,  5, 21, });
+	uint8x16_t const st8min = vminq_u8(st8a, st8b); // [ 0], [ 1], [ 2], 3, 5, 7,  9, 11
+	uint8x16_t const st8max = vmaxq_u8(st8a, st8b); // [15], [14], [13], 4, 6, 8, 10, 12
+
+	// stage 9; done so far: 0, 1, 2, 3, 4, 5, 10, 11, 12, 13, 14, 15
+	uint8x16x2_t const st8 = { { st8min, st8max } };
+	uint8x16_t const st9a = vqtbl2q_u8(st8, (uint8x16_t) {  0,  1,  2,  3, 19,  4, 20, 21, });
+	uint8x16_t const st9b = vqtbl2q_u8(st8, (uint8x16_t) { 16, 17, 18, 23,  7, 22,  5,  6, });
+	uint8x16_t const st9min = vminq_u8(st9a, st9b); // [ 0], [ 1], [ 2], [ 3], [ 4], [ 5], 6, 8
+	uint8x16_t const st9max = vmaxq_u8(st9a, st9b); // [15], [14], [13], [12], [11], [10], 7, 9
+
+	uint8x16x2_t const st9 = { { st9min, st9max } };
+	uint8x16_t const index = vqtbl2q_u8(st9, (uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 22, 7, 23, 21, 20, 19, 18, 17, 16 });
+	return index;
+}
+
+// testee04 of a batch over the given blank mask, which need not be the set's -- e.g. one with some blanks taken off
+inline size_t sort_store04(
+	uint8x16_t const vin,
+	uint8x16_t const bmask,
+	uint8_t* const output) {
+
+	// OR the mask of all blanks with the original index of the vector
+	uint8x16_t const risen = vorrq_u8(bmask, (uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 });
+
+	// now just sort that 'risen' to get the desired index of all non-blanks in the front, and all blanks in the back
+	uint8x16_t const index = sort_index04(risen);
+
+	uint8x16_t const res = vqtbl1q_u8(vin, index);
+	vst1q_u8(output, res);
+	return sizeof(uint8x16_t) + int8_t(vaddvq_u8(bmask));
+}
+
+// pruner proper, 16-batch; q-form (128-bit regs) half-utilized
+template < blank_set const& set = blank_space >
+inline size_t testee04(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	uint8x16_t const vin = vld1q_u8(input);
+	return sort_store04(vin, blank_mask< set >(vin), output);
+}
+
+// pruner proper, 16-batch; d-form (64-bit regs) version of testee04
+template < blank_set const& set = blank_space >
+inline size_t testee05(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	uint8x16_t const vin = vld1q_u8(input);
+	uint8x16_t const bmask = blank_mask< set >(vin);
+
+	// OR the mask of all blanks with the original index of the vector
+	uint8x16_t const risen = vorrq_u8(bmask, (uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 });
+
+	// now just sort that 'risen' to get the desired index of all non-blanks in the front, and all blanks in the back
+
+	// 16-element sorting network: http://pages.ripco.net/~jgamble/nw.html -- 'Best version'
+	// stage 0
+	uint8x8_t const st0a = vqtbl1_u8(risen, (uint8x8_t) { 0, 2, 4, 6, 8, 10, 12, 14 });
+	uint8x8_t const st0b = vqtbl1_u8(risen, (uint8x8_t) { 1, 3, 5, 7, 9, 11, 13, 15 });
+	uint8x8_t const st0min = vmin_u8(st0a, st0b); //  0,  2,  4,  6,  8, 10, 12, 14
+	uint8x8_t const st0max = vmax_u8(st0a, st0b); //  1,  3,  5,  7,  9, 11, 13, 15
+
+	// stage 1
+	uint8x8x2_t const st0 = { { st0min, st0max } };
+	uint8x8_t const st1a = vtbl2_u8(st0, (uint8x8_t) { 0, 2, 4, 6, 8, 10, 12, 14 });
+	uint8x8_t const st1b = vtbl2_u8(st0, (uint8x8_t) { 1, 3, 5, 7, 9, 11, 13, 15 });
+	uint8x8_t const st1min = vmin_u8(st1a, st1b); //  0,  4,  8, 12,  1,  5,  9, 13
+	uint8x8_t const st1max = vmax_u8(st1a, st1b); //  2,  6, 10, 14,  3,  7, 11, 15
+
+	// stage 2
+	uint8x8x2_t const st1 = { { st1min, st1max } };
+	uint8x8_t const st2a = vtbl2_u8(st1, (uint8x8_t) { 0, 2, 4, 6, 8, 10, 12, 14 });
+	uint8x8_t const st2b = vtbl2_u8(st1, (uint8x8_t) { 1, 3, 5, 7, 9, 11, 13, 15 });
+	uint8x8_t const st2min = vmin_u8(st2a, st2b); //  0,  8,  1,  9,  2, 10,  3, 11
+	uint8x8_t const st2max = vmax_u8(st2a, st2b); //  4, 12,  5, 13,  6, 14,  7, 15
+
+	// stage 3
+	uint8x8x2_t const st2 = { { st2min, st2max } };
+	uint8x8_t const st3a = vtbl2_u8(st2, (uint8x8_t) { 0, 2, 4, 6, 8, 10, 12, 14 });
+	uint8x8_t const st3b = vtbl2_u8(st2, (uint8x8_t) { 1, 3, 5, 7, 9, 11, 13, 15 });
+	uint8x8_t const st3min = vmin_u8(st3a, st3b); // 0, 1,  2,  3,  4,  5,  6,  7
+	uint8x8_t const st3max = vmax_u8(st3a, st3b); // 8, 9, 10, 11, 12, 13, 14, 15
+
+	// from here on some indices are already done -- freeze them, by keeping them in deterministic positions
+
+	// stage 4; indices done so far: 0, 15
+	uint8x8x2_t const st3 = { { st3min, st3max } };
+	uint8x8_t const st4a = vtbl2_u8(st3, (uint8x8_t) {  0,  5,  6,  3, 13,  7,  1,  4 });
+	uint8x8_t const st4b = vtbl2_u8(st3, (uint8x8_t) { 15, 10,  9, 12, 14, 11,  2,  8 });
+	uint8x8_t const st4min = vmin_u8(st4a, st4b); // [ 0],  5,  6,  3, 13,  7,  1,  4
+	uint8x8_t const st4max = vmax_u8(st4a, st4b); // [15], 10,  9, 12, 14, 11,  2,  8
+
+	// stage 5; done so far: 0, 15; temp frozen: 3, 12
+	uint8x8x2_t const st4 = { { st4min, st4max } };
+	uint8x8_t const st5a = vtbl2_u8(st4, (uint8x8_t) {  0,    3, 6,  5, 14, 13, 1, 10 });
+	uint8x8_t const st5b = vtbl2_u8(st4, (uint8x8_t) {  8,   11, 7,  4, 15, 12, 2,  9 });
+	uint8x8_t const st5min = vmin_u8(st5a, st5b); // [ 0], [ 3], 1,  7,  2, 11, 5,  9
+	uint8x8_t const st5max = vmax_u8(st5a, st5b); // [15], [12], 4, 13,  8, 14, 6, 10
+
+	// stage 6; done so far: 0, 1, 14, 15; temp frozen: 5, 6, 9, 10
+	uint8x8x2_t const st5 = { { st5min, st5max } };
+	uint8x8_t const st6a = vtbl2_u8(st5, (uint8x8_t) {  0,   2,  4,  5,  1,  3,  6,    7 });
+	uint8x8_t const st6b = vtbl2_u8(st5, (uint8x8_t) {  8,  13, 10, 11, 12,  9, 14,   15 });
+	uint8x8_t const st6min = vmin_u8(st6a, st6b); // [ 0], [ 1], 2, 11,  3,  7, [5], [ 9]
+	uint8x8_t const st6max = vmax_u8(st6a, st6b); // [15], [14], 4, 13,  8, 12, [6], [10]
+
+	// stage 7; done so far: 0, 1, 2, 13, 14, 15; temp frozen: 4, 11
+	uint8x8x2_t const st6 = { { st6min, st6max } };
+	uint8x8_t const st7a = vtbl2_u8(st6, (uint8x8_t) {  0,   1,    2,    3, 14, 15, 4, 5 });
+	uint8x8_t const st7b = vtbl2_u8(st6, (uint8x8_t) {  8,   9,   10,   11, 12, 13, 6, 7 });
+	uint8x8_t const st7min = vmin_u8(st7a, st7b); // [ 0], [ 1], [2], [11],  6, 10, 3, 7
+	uint8x8_t const st7max = vmax_u8(st7a, st7b); // [15], [14], [4], [13],  8, 12, 5, 9
+
+	// stage 8; done so far: 0, 1, 2, 13, 14, 15
+	uint8x8x2_t const st7 = { { st7min, st7max } };
+	uint8x8_t const st8a = vtbl2_u8(st7, (uint8x8_t) {  0,   1,    2,   6, 14,  7, 15,  3 });
+	uint8x8_t const st8b = vtbl2_u8(st7, (uint8x8_t) {  8,   9,   11,  10,  4, 12,  5, 13 });
+	uint8x8_t const st8min = vmin_u8(st8a, st8b); // [ 0], [ 1], [ 2],  3,  5,  7,  9, 11
+	uint8x8_t const st8max = vmax_u8(st8a, st8b); // [15], [14], [13],  4,  6,  8, 10, 12
+
+	// stage 9; done so far: 0, 1, 2, 3, 4, 5, 10, 11, 12, 13, 14, 15
+	uint8x8x2_t const st8 = { { st8min, st8max } };
+	uint8x8_t const st9a = vtbl2_u8(st8, (uint8x8_t) {  0,    1,    2,    3,   11,    4, 12, 13 });
+	uint8x8_t const st9b = vtbl2_u8(st8, (uint8x8_t) {  8,    9,   10,   15,    7,   14,  5,  6 });
+	uint8x8_t const st9min = vmin_u8(st9a, st9b); // [ 0], [ 1], [ 2], [ 3], [ 4], [ 5],  6,  8
+	uint8x8_t const st9max = vmax_u8(st9a, st9b); // [15], [14], [13], [12], [11], [10],  7,  9
+
+	uint8x16_t const st9 = vcombine_u8(st9min, st9max);
+	uint8x16_t const index = vqtbl1q_u8(st9, (uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 14, 7, 15, 13, 12, 11, 10, 9, 8 });
+
+	uint8x16_t const res = vqtbl1q_u8(vin, index);
+	vst1q_u8(output, res);
+	return sizeof(uint8x16_t) + int8_t(vaddvq_u8(bmask));
+}
+
+// pruner proper, 16-batch; replicates testee04/amd64
+template < blank_set const& set = blank_space >
+inline size_t testee06(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	uint8x16_t const vin = vld1q_u8(input);
+	uint8x16_t const bmask = blank_mask< set >(vin);
+
+	// get the count of non-blanks for each 4-batch
+	uint8x16_t const cmask = vaddq_u8(bmask, vdupq_n_u8(1));
+	uint8x16_t const lena = vpaddq_u8(cmask, cmask);
+	uint8x16_t const lenb = vpaddq_u8(lena, lena);
+	size_t const len0 = vgetq_lane_u8(lenb, 0);
+	size_t const len1 = vgetq_lane_u8(lenb, 1);
+	size_t const len2 = vgetq_lane_u8(lenb, 2);
+	size_t const len3 = vgetq_lane_u8(lenb, 3);
+
+	// OR the mask of all blanks with the original index of the vector
+	uint8x16_t const risen = vorrq_u8(bmask, (uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 });
+
+	// now just sort that 'risen' to get the desired index of all non-blanks in the front, and all blanks in the back;
+	// an observation: we don't need to sort the entire risen index as a whole, we can sort it piece-wise
+
+	// 4-element sorting network: http://pages.ripco.net/~jgamble/nw.html -- 'Best version', 4 clusters of
+	//
+	//  [[0,1],[2,3]]  [[4,5],[6,7]]  [[8,9],[a,b]]  [[c,d],[e,f]]
+	//  [[0,2],[1,3]]  [[4,6],[5,7]]  [[8,a],[9,b]]  [[c,e],[d,f]]
+	//  [[1,2]]        [[5,6]]        [[9,a]]        [[d,e]]
+	//
+
+	uint8x8_t const st0a = vget_low_u8(vuzp1q_u8(risen, risen));
+	uint8x8_t const st0b = vget_low_u8(vuzp2q_u8(risen, risen));
+	uint8x8_t const st0min = vmin_u8(st0a, st0b); // 0, 2, 4, 6, 8, a, c, e
+	uint8x8_t const st0max = vmax_u8(st0a, st0b); // 1, 3, 5, 7, 9, b, d, f
+
+	uint8x8_t const st1a = vtrn1_u8(st0min, st0max);
+	uint8x8_t const st1b = vtrn2_u8(st0min, st0max);
+	uint8x8_t const st1min = vmin_u8(st1a, st1b); // 0, 1, 4, 5, 8, 9, c, d
+	uint8x8_t const st1max = vmax_u8(st1a, st1b); // 2, 3, 6, 7, a, b, e, f
+
+	uint8x8_t const st2a =           st1min;
+	uint8x8_t const st2b = vrev16_u8(st1max);
+	uint8x8_t const st2min = vmin_u8(st2a, st2b); // [0], 1, [4], 5, [8], 9, [c], d
+	uint8x8_t const st2max = vmax_u8(st2a, st2b); // [3], 2, [7], 6, [b], a, [f], e
+
+	uint8x16_t const index = vreinterpretq_u8_u16(vzip1q_u16(
+		vreinterpretq_u16_u8(vcombine_u8(          st2min,  vdup_n_u8(0))),
+		vreinterpretq_u16_u8(vcombine_u8(vrev16_u8(st2max), vdup_n_u8(0)))));
+
+	uint8x16_t const res = vqtbl1q_u8(vin, index);
+
+	*reinterpret_cast< uint32_t* >(output)                      = vgetq_lane_u32(vreinterpretq_u32_u8(res), 0);
+	*reinterpret_cast< uint32_t* >(output + len0)               = vgetq_lane_u32(vreinterpretq_u32_u8(res), 1);
+	*reinterpret_cast< uint32_t* >(output + len0 + len1)        = vgetq_lane_u32(vreinterpretq_u32_u8(res), 2);
+	*reinterpret_cast< uint32_t* >(output + len0 + len1 + len2) = vgetq_lane_u32(vreinterpretq_u32_u8(res), 3);
+	return len0 + len1 + len2 + len3;
+}
+
+// pruner proper, 32-batch; wider version of testee06
+template < blank_set const& set = blank_space >
+inline size_t testee07(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	uint8x16_t const vin0 = vld1q_u8(input);
+	uint8x16_t const vin1 = vld1q_u8(input + sizeof(uint8x16_t));
+	uint8x16_t const bmask0 = blank_mask< set >(vin0);
+	uint8x16_t const bmask1 = blank_mask< set >(vin1);
+
+	// get the count of non-blanks for each 4-batch
+	uint8x16_t const cmask0 = vaddq_u8(bmask0, vdupq_n_u8(1));
+	uint8x16_t const cmask1 = vaddq_u8(bmask1, vdupq_n_u8(1));
+
+#if SAME_LATENCY_Q_AND_D
+	uint8x16_t const lena = vpaddq_u8(cmask0, cmask1);
+	uint8x16_t const lenb = vpaddq_u8(lena, lena);
+
+	size_t const len0 = vgetq_lane_u8(lenb, 0);
+	size_t const len1 = vgetq_lane_u8(lenb, 1);
+	size_t const len2 = vgetq_lane_u8(lenb, 2);
+	size_t const len3 = vgetq_lane_u8(lenb, 3);
+	size_t const len4 = vgetq_lane_u8(lenb, 4);
+	size_t const len5 = vgetq_lane_u8(lenb, 5);
+	size_t const len6 = vgetq_lane_u8(lenb, 6);
+	size_t const len7 = vgetq_lane_u8(lenb, 7);
+
+#else // when q-form of the instruction comes at extra latency (e.g. A72) use d-form instead, doubling the op count but utilizing co-issue for a net reduced latency
+	uint8x8_t const lena0 = vpadd_u8(vget_low_u8(cmask0), vget_high_u8(cmask0));
+	uint8x8_t const lena1 = vpadd_u8(vget_low_u8(cmask1), vget_high_u8(cmask1));
+	uint8x8_t const lenb0 = vpadd_u8(lena0, lena0);
+	uint8x8_t const lenb1 = vpadd_u8(lena1, lena1);
+
+	size_t const len0 = vget_lane_u8(lenb0, 0);
+	size_t const len1 = vget_lane_u8(lenb0, 1);
+	size_t const len2 = vget_lane_u8(lenb0, 2);
+	size_t const len3 = vget_lane_u8(lenb0, 3);
+	size_t const len4 = vget_lane_u8(lenb1, 0);
+	size_t const len5 = vget_lane_u8(lenb1, 1);
+	size_t const len6 = vget_lane_u8(lenb1, 2);
+	size_t const len7 = vget_lane_u8(lenb1, 3);
+
+#endif
+	// OR the mask of all blanks with the original index of the vector
+	uint8x16_t const risen0 = vorrq_u8(bmask0, (uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 });
+	uint8x16_t const risen1 = vorrq_u8(bmask1, (uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 });
+
+	// now just sort that 'risen' to get the desired index of all non-blanks in the front, and all blanks in the back;
+	// an observation: we don't need to sort the entire risen index as a whole, we can sort it piece-wise
+
+	// 4-element sorting network: http://pages.ripco.net/~jgamble/nw.html -- 'Best version', 4 clusters of
+	//
+	//  [[0,1],[2,3]]  [[4,5],[6,7]]  [[8,9],[a,b]]  [[c,d],[e,f]]
+	//  [[0,2],[1,3]]  [[4,6],[5,7]]  [[8,a],[9,b]]  [[c,e],[d,f]]
+	//  [[1,2]]        [[5,6]]        [[9,a]]        [[d,e]]
+	//
+
+	uint8x16_t const st0a = vuzp1q_u8(risen0, risen1);
+	uint8x16_t const st0b = vuzp2q_u8(risen0, risen1);
+	uint8x16_t const st0min = vminq_u8(st0a, st0b); // 0, 2, 4, 6, 8, a, c, e
+	uint8x16_t const st0max = vmaxq_u8(st0a, st0b); // 1, 3, 5, 7, 9, b, d, f
+
+	uint8x16_t const st1a = vtrn1q_u8(st0min, st0max);
+	uint8x16_t const st1b = vtrn2q_u8(st0min, st0max);
+	uint8x16_t const st1min = vminq_u8(st1a, st1b); // 0, 1, 4, 5, 8, 9, c, d
+	uint8x16_t const st1max = vmaxq_u8(st1a, st1b); // 2, 3, 6, 7, a, b, e, f
+
+	uint8x16_t const st2a =            st1min;
+	uint8x16_t const st2b = vrev16q_u8(st1max);
+	uint8x16_t const st2min = vminq_u8(st2a, st2b); // [0], 1, [4], 5, [8], 9, [c], d
+	uint8x16_t const st2max = vmaxq_u8(st2a, st2b); // [3], 2, [7], 6, [b], a, [f], e
+
+	uint16x8_t const stx = vreinterpretq_u16_u8(           st2min );
+	uint16x8_t const sty = vreinterpretq_u16_u8(vrev16q_u8(st2max));
+
+	uint8x16_t const index0 = vreinterpretq_u8_u16(vzip1q_u16(stx, sty));
+	uint8x16_t const index1 = vreinterpretq_u8_u16(vzip2q_u16(stx, sty));
+
+	uint8x16_t const res0 = vqtbl1q_u8(vin0, index0);
+	uint8x16_t const res1 = vqtbl1q_u8(vin1, index1);
+
+	// note: following len cascade is a prime candidate for implementation via prefix sum, but so far the scalar additions pipeline well
+	*reinterpret_cast< uint32_t* >(output)                                                  = vgetq_lane_u32(vreinterpretq_u32_u8(res0), 0);
+	*reinterpret_cast< uint32_t* >(output + len0)                                           = vgetq_lane_u32(vreinterpretq_u32_u8(res0), 1);
+	*reinterpret_cast< uint32_t* >(output + len0 + len1)                                    = vgetq_lane_u32(vreinterpretq_u32_u8(res0), 2);
+	*reinterpret_cast< uint32_t* >(output + len0 + len1 + len2)                             = vgetq_lane_u32(vreinterpretq_u32_u8(res0), 3);
+
+	*reinterpret_cast< uint32_t* >(output + len0 + len1 + len2 + len3)                      = vgetq_lane_u32(vreinterpretq_u32_u8(res1), 0);
+	*reinterpret_cast< uint32_t* >(output + len0 + len1 + len2 + len3 + len4)               = vgetq_lane_u32(vreinterpretq_u32_u8(res1), 1);
+	*reinterpret_cast< uint32_t* >(output + len0 + len1 + len2 + len3 + len4 + len5)        = vgetq_lane_u32(vreinterpretq_u32_u8(res1), 2);
+	*reinterpret_cast< uint32_t* >(output + len0 + len1 + len2 + len3 + len4 + len5 + len6) = vgetq_lane_u32(vreinterpretq_u32_u8(res1), 3);
+
+	return len0 + len1 + len2 + len3 + len4 + len5 + len6 + len7;
+}
+
+#if defined(__ARM_FEATURE_SVE)
+// scatter-enabled version of testee01, 64-batch on sve512
+template < blank_set const& set = blank_space >
+inline size_t testee08(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	svbool_t const pr = svptrue_pat_b8(SV_VL64); // assumed at least sve512
+
+	svuint8_t const vinput = svld1_u8(pr, input);
+	svbool_t const pr_keep = nonblank_pred< set >(pr, vinput);
+	size_t const kept = svcntp_b8(pr_keep, pr_keep);
+
+	// prefix sum of to-keep mask
+	svuint8_t prfsum = svdup_n_u8_z(pr_keep, 1);
+	prfsum = svadd_u8_x(pr, prfsum, svext_u8(svdup_n_u8(0), prfsum, 64 -  1)); // assumed exactly sve512
+	prfsum = svadd_u8_x(pr, prfsum, svext_u8(svdup_n_u8(0), prfsum, 64 -  2)); // TODO: possible to use with VLEN?
+	prfsum = svadd_u8_x(pr, prfsum, svext_u8(svdup_n_u8(0), prfsum, 64 -  4));
+	prfsum = svadd_u8_x(pr, prfsum, svext_u8(svdup_n_u8(0), prfsum, 64 -  8));
+	prfsum = svadd_u8_x(pr, prfsum, svext_u8(svdup_n_u8(0), prfsum, 64 - 16));
+	prfsum = svadd_u8_x(pr, prfsum, svext_u8(svdup_n_u8(0), prfsum, 64 - 32));
+	prfsum = svsub_u8_x(pr, prfsum, svdup_n_u8(1)); // 0-based prefix sum
+
+	// 8-bit pred -> 32-bit pred
+	svbool_t const pr_keep0 = svunpklo_b(svunpklo_b(pr_keep)); // - - - +
+	svbool_t const pr_keep1 = svunpkhi_b(svunpklo_b(pr_keep)); // - - + -
+	svbool_t const pr_keep2 = svunpklo_b(svunpkhi_b(pr_keep)); // - + - -
+	svbool_t const pr_keep3 = svunpkhi_b(svunpkhi_b(pr_keep)); // + - - -
+
+	// 8-bit chars -> 32-bit chars
+	svuint32_t const winput0 = svunpklo_u32(svunpklo_u16(vinput));
+	svuint32_t const winput1 = svunpkhi_u32(svunpklo_u16(vinput));
+	svuint32_t const winput2 = svunpklo_u32(svunpkhi_u16(vinput));
+	svuint32_t const winput3 = svunpkhi_u32(svunpkhi_u16(vinput));
+
+	// 8-bit offsets -> 32-bit offsets
+	svuint32_t const woffset0 = svunpklo_u32(svunpklo_u16(prfsum));
+	svuint32_t const woffset1 = svunpkhi_u32(svunpklo_u16(prfsum));
+	svuint32_t const woffset2 = svunpklo_u32(svunpkhi_u16(prfsum));
+	svuint32_t const woffset3 = svunpkhi_u32(svunpkhi_u16(prfsum));
+
+	if (svptest_any(pr_keep0, pr_keep0))
+		svst1b_scatter_offset(pr_keep0, output, woffset0, winput0);
+
+	if (svptest_any(pr_keep1, pr_keep1))
+		svst1b_scatter_offset(pr_keep1, output, woffset1, winput1);
+
+	if (svptest_any(pr_keep2, pr_keep2))
+		svst1b_scatter_offset(pr_keep2, output, woffset2, winput2);
+
+	if (svptest_any(pr_keep3, pr_keep3))
+		svst1b_scatter_offset(pr_keep3, output, woffset3, winput3);
+
+	return kept;
+}
+
+
+// pruner proper, vector-length agnostic successor of testee08; the chars active under pr are widened to 32-bit by
+// quarters and compacted -- svcompact is not available for 8-bit elements before sve2.2 -- then narrowed back by
+// truncating stores of just the kept chars, so nothing past the non-blanks is written
+template < blank_set const& set = blank_space >
+inline size_t testee10(
+	uint8_t const* const input,
+	uint8_t* const output,
+	svbool_t const pr = svptrue_b8()) {
+
+	svuint8_t const vin = svld1_u8(pr, input);
+	svbool_t const pr_keep = nonblank_pred< set >(pr, vin);
+
+	// 8-bit pred -> 32-bit pred
+	svbool_t const pr_keep0 = svunpklo_b(svunpklo_b(pr_keep));
+	svbool_t const pr_keep1 = svunpkhi_b(svunpklo_b(pr_keep));
+	svbool_t const pr_keep2 = svunpklo_b(svunpkhi_b(pr_keep));
+	svbool_t const pr_keep3 = svunpkhi_b(svunpkhi_b(pr_keep));
+
+	// 8-bit chars -> 32-bit chars, compacted
+	svuint32_t const winput0 = svcompact_u32(pr_keep0, svunpklo_u32(svunpklo_u16(vin)));
+	svuint32_t const winput1 = svcompact_u32(pr_keep1, svunpkhi_u32(svunpklo_u16(vin)));
+	svuint32_t const winput2 = svcompact_u32(pr_keep2, svunpklo_u32(svunpkhi_u16(vin)));
+	svuint32_t const winput3 = svcompact_u32(pr_keep3, svunpkhi_u32(svunpkhi_u16(vin)));
+
+	uint64_t const len0 = svcntp_b32(pr_keep0, pr_keep0);
+	uint64_t const len1 = svcntp_b32(pr_keep1, pr_keep1);
+	uint64_t const len2 = svcntp_b32(pr_keep2, pr_keep2);
+	uint64_t const len3 = svcntp_b32(pr_keep3, pr_keep3);
+
+	svst1b_u32(svwhilelt_b32_u64(0, len0), output,                      winput0);
+	svst1b_u32(svwhilelt_b32_u64(0, len1), output + len0,               winput1);
+	svst1b_u32(svwhilelt_b32_u64(0, len2), output + len0 + len1,        winput2);
+	svst1b_u32(svwhilelt_b32_u64(0, len3), output + len0 + len1 + len2, winput3);
+	return len0 + len1 + len2 + len3;
+}
+#endif
+#elif __x86_64__ || __i386__
+// the sorting network of testee04: sort a risen index, i.e. one whose blank lanes have their top bit set, piece-wise
+// -- each 4-lane cluster gets the original indices of its non-blanks first, in order; an observation: we don't need
+// to sort the entire risen index as a whole
+TARGET_SSSE3 inline __m128i sort_index04(__m128i const risen) {
+
+	// 4-element sorting network: http://pages.ripco.net/~jgamble/nw.html -- 'Best version', 4 clusters of
+	//
+	//  [[0,1],[2,3]]  [[4,5],[6,7]]  [[8,9],[a,b]]  [[c,d],[e,f]]
+	//  [[0,2],[1,3]]  [[4,6],[5,7]]  [[8,a],[9,b]]  [[c,e],[d,f]]
+	//  [[1,2]]        [[5,6]]        [[9,a]]        [[d,e]]
+	//
+
+	__m128i const st0a = _mm_shuffle_epi8(risen, _mm_setr_epi8(0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st0b = _mm_shuffle_epi8(risen, _mm_setr_epi8(1, 3, 5, 7, 9, 11, 13, 15, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st0min = _mm_min_epu8(st0a, st0b); // 0, 2, 4, 6, 8, a, c, e
+	__m128i const st0max = _mm_max_epu8(st0a, st0b); // 1, 3, 5, 7, 9, b, d, f
+
+	__m128i const st0 = _mm_unpacklo_epi64(st0min, st0max);
+	__m128i const st1a = _mm_shuffle_epi8(st0, _mm_setr_epi8(0, 8, 2, 10, 4, 12, 6, 14, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st1b = _mm_shuffle_epi8(st0, _mm_setr_epi8(1, 9, 3, 11, 5, 13, 7, 15, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st1min = _mm_min_epu8(st1a, st1b); // 0, 1, 4, 5, 8, 9, c, d
+	__m128i const st1max = _mm_max_epu8(st1a, st1b); // 2, 3, 6, 7, a, b, e, f
+
+	__m128i const st2a =                  st1min;
+	__m128i const st2b = _mm_shuffle_epi8(st1max, _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st2min = _mm_min_epu8(st2a, st2b); // [0], 1, [4], 5, [8], 9, [c], d
+	__m128i const st2max = _mm_max_epu8(st2a, st2b); // [3], 2, [7], 6, [b], a, [f], e
+
+	__m128i const st2 = _mm_unpacklo_epi64(st2min, st2max);
+	__m128i const index = _mm_shuffle_epi8(st2, _mm_setr_epi8(0, 1, 9, 8, 2, 3, 11, 10, 4, 5, 13, 12, 6, 7, 15, 14));
+	return index;
+}
+
+// output offsets of pieces 1 - 3 of a batch sorted by sort_index04 -- the counts of non-blanks ahead of each -- by the
+// batch's non-blank bitmask
+struct pieces04 {
+	uint32_t len0;
+	uint32_t len1;
+	uint32_t len2;
+};
+
+TARGET_SSSE3_POPCNT inline pieces04 pieces_of04(uint32_t const bitmask) {
+	pieces04 const p = {
+		uint32_t(_mm_popcnt_u32(bitmask & 0x00f)),
+		uint32_t(_mm_popcnt_u32(bitmask & 0x0ff)),
+		uint32_t(_mm_popcnt_u32(bitmask & 0xfff))
+	};
+	return p;
+}
+
+// store the 4-lane pieces of a batch sorted by sort_index04 back to back, each at its offset; every store is 4 chars
+// wide, the lanes past a piece's non-blanks being overwritten by the next piece, or left past the batch's output
+TARGET_SSSE3 inline void store_pieces04(
+	__m128i const res,
+	pieces04 const p,
+	uint8_t* const output) {
+
+	*reinterpret_cast< uint32_t* >(output)          = _mm_cvtsi128_si32(res);
+	*reinterpret_cast< uint32_t* >(output + p.len0) = _mm_cvtsi128_si32(_mm_shuffle_epi32(res, 0x55));
+	*reinterpret_cast< uint32_t* >(output + p.len1) = _mm_cvtsi128_si32(_mm_shuffle_epi32(res, 0xee));
+	*reinterpret_cast< uint32_t* >(output + p.len2) = _mm_cvtsi128_si32(_mm_shuffle_epi32(res, 0xff));
+}
+
+// testee04 of a batch over the given blank mask, which need not be the set's -- e.g. one with some blanks taken off
+TARGET_SSSE3_POPCNT inline size_t sort_store04(
+	__m128i const vin,
+	__m128i const bmask,
+	uint8_t* const output) {
+
+	// OR the mask of all blanks with the original index of the vector
+	__m128i const risen = _mm_or_si128(bmask, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+
+	// now just sort that 'risen' to get the desired index of non-blanks in the front of each 4-lane cluster
+	__m128i const index = sort_index04(risen);
+
+	uint32_t const bitmask = ~_mm_movemask_epi8(bmask);
+	store_pieces04(_mm_shuffle_epi8(vin, index), pieces_of04(bitmask), output);
+	return _mm_popcnt_u32(bitmask & 0xffff);
+}
+
+// pruner proper, 16-batch; amd64 cannot properly recreate arm64's testee04, so get creative
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t testee04(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	__m128i const vin = _mm_loadu_si128(reinterpret_cast< __m128i const* >(input));
+	return sort_store04(vin, blank_mask< set >(vin), output);
+}
+
+// pruner proper, 16-batch
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t testee05(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	__m128i const vin = _mm_loadu_si128(reinterpret_cast< __m128i const* >(input));
+	__m128i const bmask = blank_mask< set >(vin);
+
+	// OR the mask of all blanks with the original index of the vector
+	__m128i const risen = _mm_or_si128(bmask, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+
+	// now just sort that 'risen' to get the desired index of all non-blanks in the front, and all blanks in the back
+
+	// 16-element sorting network: http://pages.ripco.net/~jgamble/nw.html -- 'Best version'
+	// stage 0
+	__m128i const st0a = _mm_shuffle_epi8(risen, _mm_setr_epi8( 0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st0b = _mm_shuffle_epi8(risen, _mm_setr_epi8( 1, 3, 5, 7, 9, 11, 13, 15, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st0min = _mm_min_epu8(st0a, st0b); //  0, 2, 4, 6, 8, 10, 12, 14
+	__m128i const st0max = _mm_max_epu8(st0a, st0b); //  1, 3, 5, 7, 9, 11, 13, 15
+
+	// stage 1
+	__m128i const st0 = _mm_unpacklo_epi64(st0min, st0max);
+	__m128i const st1a = _mm_shuffle_epi8(st0, _mm_setr_epi8( 0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st1b = _mm_shuffle_epi8(st0, _mm_setr_epi8( 1, 3, 5, 7, 9, 11, 13, 15, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st1min = _mm_min_epu8(st1a, st1b); //  0, 4,  8, 12, 1, 5,  9, 13
+	__m128i const st1max = _mm_max_epu8(st1a, st1b); //  2, 6, 10, 14, 3, 7, 11, 15
+
+	// stage 2
+	__m128i const st1 = _mm_unpacklo_epi64(st1min, st1max);
+	__m128i const st2a = _mm_shuffle_epi8(st1, _mm_setr_epi8( 0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st2b = _mm_shuffle_epi8(st1, _mm_setr_epi8( 1, 3, 5, 7, 9, 11, 13, 15, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st2min = _mm_min_epu8(st2a, st2b); //  0,  8, 1,  9, 2, 10, 3, 11
+	__m128i const st2max = _mm_max_epu8(st2a, st2b); //  4, 12, 5, 13, 6, 14, 7, 15
+
+	// stage 3
+	__m128i const st2 = _mm_unpacklo_epi64(st2min, st2max);
+	__m128i const st3a = _mm_shuffle_epi8(st2, _mm_setr_epi8( 0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st3b = _mm_shuffle_epi8(st2, _mm_setr_epi8( 1, 3, 5, 7, 9, 11, 13, 15, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st3min = _mm_min_epu8(st3a, st3b); // 0, 1,  2,  3,  4,  5,  6,  7
+	__m128i const st3max = _mm_max_epu8(st3a, st3b); // 8, 9, 10, 11, 12, 13, 14, 15
+
+	// from here on some indices are already done -- freeze them, by keeping them in deterministic positions
+
+	// stage 4; indices done so far: 0, 15
+	__m128i const st3 = _mm_unpacklo_epi64(st3min, st3max);
+	__m128i const st4a = _mm_shuffle_epi8(st3, _mm_setr_epi8( 0,  5, 6,  3, 13,  7, 1, 4, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st4b = _mm_shuffle_epi8(st3, _mm_setr_epi8(15, 10, 9, 12, 14, 11, 2, 8, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st4min = _mm_min_epu8(st4a, st4b); // [ 0],  5,  6,  3, 13,  7,  1,  4
+	__m128i const st4max = _mm_max_epu8(st4a, st4b); // [15], 10,  9, 12, 14, 11,  2,  8
+
+	// stage 5; done so far: 0, 15; temp frozen: 3, 12
+	__m128i const st4 = _mm_unpacklo_epi64(st4min, st4max);
+	__m128i const st5a = _mm_shuffle_epi8(st4, _mm_setr_epi8( 0,  3, 6, 5, 14, 13, 1, 10, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st5b = _mm_shuffle_epi8(st4, _mm_setr_epi8( 8, 11, 7, 4, 15, 12, 2,  9, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st5min = _mm_min_epu8(st5a, st5b); // [ 0], [ 3], 1,  7,  2, 11, 5,  9
+	__m128i const st5max = _mm_max_epu8(st5a, st5b); // [15], [12], 4, 13,  8, 14, 6, 10
+
+	// stage 6; done so far: 0, 1, 14, 15; temp frozen: 5, 6, 9, 10
+	__m128i const st5 = _mm_unpacklo_epi64(st5min, st5max);
+	__m128i const st6a = _mm_shuffle_epi8(st5, _mm_setr_epi8( 0,  2,  4,  5,  1, 3,  6,  7, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st6b = _mm_shuffle_epi8(st5, _mm_setr_epi8( 8, 13, 10, 11, 12, 9, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st6min = _mm_min_epu8(st6a, st6b); // [ 0], [ 1], 2, 11,  3,  7, [5], [ 9]
+	__m128i const st6max = _mm_max_epu8(st6a, st6b); // [15], [14], 4, 13,  8, 12, [6], [10]
+
+	// stage 7; done so far: 0, 1, 2, 13, 14, 15; temp frozen: 4, 11
+	__m128i const st6 = _mm_unpacklo_epi64(st6min, st6max);
+	__m128i const st7a = _mm_shuffle_epi8(st6, _mm_setr_epi8( 0, 1,  2,  3, 14, 15, 4, 5, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st7b = _mm_shuffle_epi8(st6, _mm_setr_epi8( 8, 9, 10, 11, 12, 13, 6, 7, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st7min = _mm_min_epu8(st7a, st7b); // [ 0], [ 1], [2], [11],  6, 10, 3, 7
+	__m128i const st7max = _mm_max_epu8(st7a, st7b); // [15], [14], [4], [13],  8, 12, 5, 9
+
+	// stage 8; done so far: 0, 1, 2, 13, 14, 15
+	__m128i const st7 = _mm_unpacklo_epi64(st7min, st7max);
+	__m128i const st8a = _mm_shuffle_epi8(st7, _mm_setr_epi8( 0, 1,  2,  6, 14,  7, 15,  3, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st8b = _mm_shuffle_epi8(st7, _mm_setr_epi8( 8, 9, 11, 10,  4, 12,  5, 13, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st8min = _mm_min_epu8(st8a, st8b); // [ 0], [ 1], [ 2],  3,  5,  7,  9, 11
+	__m128i const st8max = _mm_max_epu8(st8a, st8b); // [15], [14], [13],  4,  6,  8, 10, 12
+
+	// stage 9; done so far: 0, 1, 2, 3, 4, 5, 10, 11, 12, 13, 14, 15
+	__m128i const st8 = _mm_unpacklo_epi64(st8min, st8max);
+	__m128i const st9a = _mm_shuffle_epi8(st8, _mm_setr_epi8( 0, 1,  2,  3, 11,  4, 12, 13, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st9b = _mm_shuffle_epi8(st8, _mm_setr_epi8( 8, 9, 10, 15,  7, 14,  5,  6, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m128i const st9min = _mm_min_epu8(st9a, st9b); // [ 0], [ 1], [ 2], [ 3], [ 4], [ 5],  6,  8
+	__m128i const st9max = _mm_max_epu8(st9a, st9b); // [15], [14], [13], [12], [11], [10],  7,  9
+
+	__m128i const st9 = _mm_unpacklo_epi64(st9min, st9max);
+	__m128i const index = _mm_shuffle_epi8(st9, _mm_setr_epi8( 0, 1, 2, 3, 4, 5, 6, 14, 7, 15, 13, 12, 11, 10, 9, 8 ));
+
+	__m128i const res = _mm_shuffle_epi8(vin, index);
+	_mm_storeu_si128(reinterpret_cast< __m128i* >(output), res);
+	return sizeof(__m128i) - _mm_popcnt_u32(_mm_movemask_epi8(bmask));
+}
+
+#if __x86_64__
+// testee07 of a batch over the given blank mask, which need not be the set's -- e.g. one with some blanks taken off
+TARGET_AVX2 inline size_t sort_store07(
+	__m256i const vin,
+	__m256i const bmask,
+	uint8_t* const output) {
+
+	// OR the mask of all blanks with the original index of the lane
+	__m256i const risen = _mm256_or_si256(bmask, _mm256_setr_epi8(
+		0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+		0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+
+	// now just sort that 'risen' to get the desired index of all non-blanks in the front, and all blanks in the back;
+	// same as testee04, 4-element sorting network, 4 clusters per lane
+
+	__m256i const st0a = _mm256_shuffle_epi8(risen, _mm256_setr_epi8(
+		0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1,
+		0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m256i const st0b = _mm256_shuffle_epi8(risen, _mm256_setr_epi8(
+		1, 3, 5, 7, 9, 11, 13, 15, -1, -1, -1, -1, -1, -1, -1, -1,
+		1, 3, 5, 7, 9, 11, 13, 15, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m256i const st0min = _mm256_min_epu8(st0a, st0b); // 0, 2, 4, 6, 8, a, c, e
+	__m256i const st0max = _mm256_max_epu8(st0a, st0b); // 1, 3, 5, 7, 9, b, d, f
+
+	__m256i const st0 = _mm256_unpacklo_epi64(st0min, st0max);
+	__m256i const st1a = _mm256_shuffle_epi8(st0, _mm256_setr_epi8(
+		0, 8, 2, 10, 4, 12, 6, 14, -1, -1, -1, -1, -1, -1, -1, -1,
+		0, 8, 2, 10, 4, 12, 6, 14, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m256i const st1b = _mm256_shuffle_epi8(st0, _mm256_setr_epi8(
+		1, 9, 3, 11, 5, 13, 7, 15, -1, -1, -1, -1, -1, -1, -1, -1,
+		1, 9, 3, 11, 5, 13, 7, 15, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m256i const st1min = _mm256_min_epu8(st1a, st1b); // 0, 1, 4, 5, 8, 9, c, d
+	__m256i const st1max = _mm256_max_epu8(st1a, st1b); // 2, 3, 6, 7, a, b, e, f
+
+	__m256i const st2a =                     st1min;
+	__m256i const st2b = _mm256_shuffle_epi8(st1max, _mm256_setr_epi8(
+		1, 0, 3, 2, 5, 4, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1,
+		1, 0, 3, 2, 5, 4, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1));
+	__m256i const st2min = _mm256_min_epu8(st2a, st2b); // [0], 1, [4], 5, [8], 9, [c], d
+	__m256i const st2max = _mm256_max_epu8(st2a, st2b); // [3], 2, [7], 6, [b], a, [f], e
+
+	__m256i const st2 = _mm256_unpacklo_epi64(st2min, st2max);
+	__m256i const index = _mm256_shuffle_epi8(st2, _mm256_setr_epi8(
+		0, 1, 9, 8, 2, 3, 11, 10, 4, 5, 13, 12, 6, 7, 15, 14,
+		0, 1, 9, 8, 2, 3, 11, 10, 4, 5, 13, 12, 6, 7, 15, 14));
+
+	__m256i const res = _mm256_shuffle_epi8(vin, index);
+
+	// fetch the 4-batches by pairs -- gpr extracts are cheaper than a cross-lane permute per 4-batch
+	__m128i const res0 = _mm256_castsi256_si128(res);
+	__m128i const res1 = _mm256_extracti128_si256(res, 1);
+	uint64_t const res01 = _mm_cvtsi128_si64(res0);
+	uint64_t const res23 = _mm_extract_epi64(res0, 1);
+	uint64_t const res45 = _mm_cvtsi128_si64(res1);
+	uint64_t const res67 = _mm_extract_epi64(res1, 1);
+
+	uint32_t const bitmask = ~_mm256_movemask_epi8(bmask);
+	uint32_t const len0 = _mm_popcnt_u32(bitmask & 0x0000000f);
+	uint32_t const len1 = _mm_popcnt_u32(bitmask & 0x000000ff);
+	uint32_t const len2 = _mm_popcnt_u32(bitmask & 0x00000fff);
+	uint32_t const len3 = _mm_popcnt_u32(bitmask & 0x0000ffff);
+	uint32_t const len4 = _mm_popcnt_u32(bitmask & 0x000fffff);
+	uint32_t const len5 = _mm_popcnt_u32(bitmask & 0x00ffffff);
+	uint32_t const len6 = _mm_popcnt_u32(bitmask & 0x0fffffff);
+
+	*reinterpret_cast< uint32_t* >(output)        = uint32_t(res01);
+	*reinterpret_cast< uint32_t* >(output + len0) = uint32_t(res01 >> 32);
+	*reinterpret_cast< uint32_t* >(output + len1) = uint32_t(res23);
+	*reinterpret_cast< uint32_t* >(output + len2) = uint32_t(res23 >> 32);
+	*reinterpret_cast< uint32_t* >(output + len3) = uint32_t(res45);
+	*reinterpret_cast< uint32_t* >(output + len4) = uint32_t(res45 >> 32);
+	*reinterpret_cast< uint32_t* >(output + len5) = uint32_t(res67);
+	*reinterpret_cast< uint32_t* >(output + len6) = uint32_t(res67 >> 32);
+	return _mm_popcnt_u32(bitmask);
+}
+
+// pruner proper, 32-batch; avx2 port of arm64's testee07 -- testee04's piece-wise sort, carried out across both 128-bit
+// lanes of a ymm at once, as vpshufb is in-lane anyway
+template < blank_set const& set = blank_space >
+TARGET_AVX2 inline size_t testee07(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	__m256i const vin = _mm256_loadu_si256(reinterpret_cast< __m256i const* >(input));
+	return sort_store07(vin, blank_mask< set >(vin), output);
+}
+
+// pruner proper, 64-batch; twice-wider version of testee07/amd64, two independent sorts for co-issue
+template < blank_set const& set = blank_space >
+TARGET_AVX2 inline size_t testee09(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	__m256i const vin0 = _mm256_loadu_si256(reinterpret_cast< __m256i const* >(input));
+	__m256i const vin1 = _mm256_loadu_si256(reinterpret_cast< __m256i const* >(input) + 1);
+	__m256i const bmask0 = blank_mask< set >(vin0);
+	__m256i const bmask1 = blank_mask< set >(vin1);
+
+	// OR the mask of all blanks with the original index of the lane
+	__m256i const lane_index = _mm256_setr_epi8(
+		0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+		0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	__m256i const risen0 = _mm256_or_si256(bmask0, lane_index);
+	__m256i const risen1 = _mm256_or_si256(bmask1, lane_index);
+
+	// same as testee07/amd64
+	__m256i const evn = _mm256_setr_epi8(
+		0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1,
+		0, 2, 4, 6, 8, 10, 12, 14, -1, -1, -1, -1, -1, -1, -1, -1);
+	__m256i const odd = _mm256_setr_epi8(
+		1, 3, 5, 7, 9, 11, 13, 15, -1, -1, -1, -1, -1, -1, -1, -1,
+		1, 3, 5, 7, 9, 11, 13, 15, -1, -1, -1, -1, -1, -1, -1, -1);
+
+	__m256i const st0a0 = _mm256_shuffle_epi8(risen0, evn);
+	__m256i const st0a1 = _mm256_shuffle_epi8(risen1, evn);
+	__m256i const st0b0 = _mm256_shuffle_epi8(risen0, odd);
+	__m256i const st0b1 = _mm256_shuffle_epi8(risen1, odd);
+	__m256i const st0min0 = _mm256_min_epu8(st0a0, st0b0); // 0, 2, 4, 6, 8, a, c, e
+	__m256i const st0min1 = _mm256_min_epu8(st0a1, st0b1);
+	__m256i const st0max0 = _mm256_max_epu8(st0a0, st0b0); // 1, 3, 5, 7, 9, b, d, f
+	__m256i const st0max1 = _mm256_max_epu8(st0a1, st0b1);
+
+	__m256i const stx = _mm256_setr_epi8(
+		0, 8, 2, 10, 4, 12, 6, 14, -1, -1, -1, -1, -1, -1, -1, -1,
+		0, 8, 2, 10, 4, 12, 6, 14, -1, -1, -1, -1, -1, -1, -1, -1);
+	__m256i const sty = _mm256_setr_epi8(
+		1, 9, 3, 11, 5, 13, 7, 15, -1, -1, -1, -1, -1, -1, -1, -1,
+		1, 9, 3, 11, 5, 13, 7, 15, -1, -1, -1, -1, -1, -1, -1, -1);
+
+	__m256i const st00 = _mm256_unpacklo_epi64(st0min0, st0max0);
+	__m256i const st01 = _mm256_unpacklo_epi64(st0min1, st0max1);
+	__m256i const st1a0 = _mm256_shuffle_epi8(st00, stx);
+	__m256i const st1a1 = _mm256_shuffle_epi8(st01, stx);
+	__m256i const st1b0 = _mm256_shuffle_epi8(st00, sty);
+	__m256i const st1b1 = _mm256_shuffle_epi8(st01, sty);
+	__m256i const st1min0 = _mm256_min_epu8(st1a0, st1b0); // 0, 1, 4, 5, 8, 9, c, d
+	__m256i const st1min1 = _mm256_min_epu8(st1a1, st1b1);
+	__m256i const st1max0 = _mm256_max_epu8(st1a0, st1b0); // 2, 3, 6, 7, a, b, e, f
+	__m256i const st1max1 = _mm256_max_epu8(st1a1, st1b1);
+
+	__m256i const swp = _mm256_setr_epi8(
+		1, 0, 3, 2, 5, 4, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1,
+		1, 0, 3, 2, 5, 4, 7, 6, -1, -1, -1, -1, -1, -1, -1, -1);
+
+	__m256i const st2b0 = _mm256_shuffle_epi8(st1max0, swp);
+	__m256i const st2b1 = _mm256_shuffle_epi8(st1max1, swp);
+	__m256i const st2min0 = _mm256_min_epu8(st1min0, st2b0); // [0], 1, [4], 5, [8], 9, [c], d
+	__m256i const st2min1 = _mm256_min_epu8(st1min1, st2b1);
+	__m256i const st2max0 = _mm256_max_epu8(st1min0, st2b0); // [3], 2, [7], 6, [b], a, [f], e
+	__m256i const st2max1 = _mm256_max_epu8(st1min1, st2b1);
+
+	__m256i const fin = _mm256_setr_epi8(
+		0, 1, 9, 8, 2, 3, 11, 10, 4, 5, 13, 12, 6, 7, 15, 14,
+		0, 1, 9, 8, 2, 3, 11, 10, 4, 5, 13, 12, 6, 7, 15, 14);
+
+	__m256i const index0 = _mm256_shuffle_epi8(_mm256_unpacklo_epi64(st2min0, st2max0), fin);
+	__m256i const index1 = _mm256_shuffle_epi8(_mm256_unpacklo_epi64(st2min1, st2max1), fin);
+
+	__m256i const res0 = _mm256_shuffle_epi8(vin0, index0);
+	__m256i const res1 = _mm256_shuffle_epi8(vin1, index1);
+
+	__m128i const res00 = _mm256_castsi256_si128(res0);
+	__m128i const res01 = _mm256_extracti128_si256(res0, 1);
+	__m128i const res10 = _mm256_castsi256_si128(res1);
+	__m128i const res11 = _mm256_extracti128_si256(res1, 1);
+	uint64_t const resA = _mm_cvtsi128_si64(res00);
+	uint64_t const resB = _mm_extract_epi64(res00, 1);
+	uint64_t const resC = _mm_cvtsi128_si64(res01);
+	uint64_t const resD = _mm_extract_epi64(res01, 1);
+	uint64_t const resE = _mm_cvtsi128_si64(res10);
+	uint64_t const resF = _mm_extract_epi64(res10, 1);
+	uint64_t const resG = _mm_cvtsi128_si64(res11);
+	uint64_t const resH = _mm_extract_epi64(res11, 1);
+
+	uint64_t const bitmask = ~(uint64_t(uint32_t(_mm256_movemask_epi8(bmask1))) << 32 | uint32_t(_mm256_movemask_epi8(bmask0)));
+	uint64_t const len0 = _mm_popcnt_u64(bitmask & 0x000000000000000f);
+	uint64_t const len1 = _mm_popcnt_u64(bitmask & 0x00000000000000ff);
+	uint64_t const len2 = _mm_popcnt_u64(bitmask & 0x0000000000000fff);
+	uint64_t const len3 = _mm_popcnt_u64(bitmask & 0x000000000000ffff);
+	uint64_t const len4 = _mm_popcnt_u64(bitmask & 0x00000000000fffff);
+	uint64_t const len5 = _mm_popcnt_u64(bitmask & 0x0000000000ffffff);
+	uint64_t const len6 = _mm_popcnt_u64(bitmask & 0x000000000fffffff);
+	uint64_t const len7 = _mm_popcnt_u64(bitmask & 0x00000000ffffffff);
+	uint64_t const len8 = _mm_popcnt_u64(bitmask & 0x0000000fffffffff);
+	uint64_t const len9 = _mm_popcnt_u64(bitmask & 0x000000ffffffffff);
+	uint64_t const lenA = _mm_popcnt_u64(bitmask & 0x00000fffffffffff);
+	uint64_t const lenB = _mm_popcnt_u64(bitmask & 0x0000ffffffffffff);
+	uint64_t const lenC = _mm_popcnt_u64(bitmask & 0x000fffffffffffff);
+	uint64_t const lenD = _mm_popcnt_u64(bitmask & 0x00ffffffffffffff);
+	uint64_t const lenE = _mm_popcnt_u64(bitmask & 0x0fffffffffffffff);
+
+	*reinterpret_cast< uint32_t* >(output)        = uint32_t(resA);
+	*reinterpret_cast< uint32_t* >(output + len0) = uint32_t(resA >> 32);
+	*reinterpret_cast< uint32_t* >(output + len1) = uint32_t(resB);
+	*reinterpret_cast< uint32_t* >(output + len2) = uint32_t(resB >> 32);
+	*reinterpret_cast< uint32_t* >(output + len3) = uint32_t(resC);
+	*reinterpret_cast< uint32_t* >(output + len4) = uint32_t(resC >> 32);
+	*reinterpret_cast< uint32_t* >(output + len5) = uint32_t(resD);
+	*reinterpret_cast< uint32_t* >(output + len6) = uint32_t(resD >> 32);
+	*reinterpret_cast< uint32_t* >(output + len7) = uint32_t(resE);
+	*reinterpret_cast< uint32_t* >(output + len8) = uint32_t(resE >> 32);
+	*reinterpret_cast< uint32_t* >(output + len9) = uint32_t(resF);
+	*reinterpret_cast< uint32_t* >(output + lenA) = uint32_t(resF >> 32);
+	*reinterpret_cast< uint32_t* >(output + lenB) = uint32_t(resG);
+	*reinterpret_cast< uint32_t* >(output + lenC) = uint32_t(resG >> 32);
+	*reinterpret_cast< uint32_t* >(output + lenD) = uint32_t(resH);
+	*reinterpret_cast< uint32_t* >(output + lenE) = uint32_t(resH >> 32);
+	return _mm_popcnt_u64(bitmask);
+}
+
+#endif
+#endif
+// look-up-table pruners: rather than sorted, the index of a batch is looked up by the batch's blank bitmask, piece by
+// piece, in tables small enough to share L1 with other work -- the original ssse3 pruner looks its index up in a
+// single 2^16-entry table of 16-byte entries, 1MB; each piece of the index is stored at the running count of
+// non-blanks, as with testee04
+//
+//   testee11: 4-bit pieces; 16 entries of 8 bytes, 4-lane index and count of non-blanks: 128B
+//   testee12: 8-bit pieces; 256 entries of 8 bytes, 8-lane index: 2KB
+//   testee13: 8-bit pieces, the high piece's index pre-shifted by each possible count of non-blanks in the low one,
+//             so the two merge by an OR into one 16-lane index and store; 256 entries of 16 bytes for the low piece,
+//             256 x 9 for the high one: 40KB
+//
+// Unused lanes of testee13's entries are zero, so either entry's lanes pass the OR intact; past the non-blanks, the
+// merged index samples junk, as with the sorted one.
+
+struct lut4_table {
+	uint64_t entry[16];
+};
+
+struct lut8_table {
+	uint64_t entry[256];
+};
+
+struct lut16_table {
+	uint8_t lo[256][16] __attribute__ ((aligned(16)));
+	uint8_t hi[256][9][16] __attribute__ ((aligned(16)));
+};
+
+constexpr lut4_table lut4_make() {
+	lut4_table lut = {};
+	for (unsigned m = 0; m < 16; ++m) {
+		unsigned k = 0;
+		for (unsigned i = 0; i < 4; ++i)
+			if (0 == (m >> i & 1))
+				lut.entry[m] |= uint64_t(i) << 8 * k++;
+
+		lut.entry[m] |= uint64_t(k) << 32;
+	}
+	return lut;
+}
+
+constexpr lut8_table lut8_make() {
+	lut8_table lut = {};
+	for (unsigned m = 0; m < 256; ++m) {
+		unsigned k = 0;
+		for (unsigned i = 0; i < 8; ++i)
+			if (0 == (m >> i & 1))
+				lut.entry[m] |= uint64_t(i) << 8 * k++;
+	}
+	return lut;
+}
+
+constexpr lut16_table lut16_make() {
+	lut16_table lut = {};
+	for (unsigned m = 0; m < 256; ++m) {
+		unsigned n = 0;
+		for (unsigned i = 0; i < 8; ++i)
+			if (0 == (m >> i & 1))
+				lut.lo[m][n++] = uint8_t(i);
+
+		for (unsigned k = 0; k < 9; ++k) {
+			n = k;
+			for (unsigned i = 0; i < 8; ++i)
+				if (0 == (m >> i & 1))
+					lut.hi[m][k][n++] = uint8_t(8 + i);
+		}
+	}
+	return lut;
+}
+
+constexpr lut4_table lut4 = lut4_make();
+constexpr lut8_table lut8 = lut8_make();
+constexpr lut16_table lut16 = lut16_make();
+
+#if __aarch64__
+// 16-bit blank bitmask of a batch, as the low and high 8 bits
+inline void blank_bits(
+	uint8x16_t const bmask,
+	uint32_t& lo,
+	uint32_t& hi) {
+
+	uint8x16_t const bits = vandq_u8(bmask, (uint8x16_t) { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 });
+	lo = vaddv_u8(vget_low_u8(bits));
+	hi = vaddv_u8(vget_high_u8(bits));
+}
+
+// look-up-table pruner, 16-batch; 128B table
+template < blank_set const& set = blank_space >
+inline size_t testee11(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	uint8x16_t const vin = vld1q_u8(input);
+	uint32_t lo, hi;
+	blank_bits(blank_mask< set >(vin), lo, hi);
+
+	uint64_t const e0 = lut4.entry[lo & 15];
+	uint64_t const e1 = lut4.entry[lo >> 4];
+	uint64_t const e2 = lut4.entry[hi & 15];
+	uint64_t const e3 = lut4.entry[hi >> 4];
+
+	// the 4-lane indices, each raised by the base lane of its piece
+	uint32x4_t const piece = { uint32_t(e0), uint32_t(e1), uint32_t(e2), uint32_t(e3) };
+	uint8x16_t const index = vaddq_u8(vreinterpretq_u8_u32(piece), (uint8x16_t) { 0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8, 12, 12, 12, 12 });
+	uint8x16_t const res = vqtbl1q_u8(vin, index);
+
+	size_t const len0 = size_t(e0 >> 32);
+	size_t const len1 = size_t(e1 >> 32) + len0;
+	size_t const len2 = size_t(e2 >> 32) + len1;
+
+	*reinterpret_cast< uint32_t* >(output)        = vgetq_lane_u32(vreinterpretq_u32_u8(res), 0);
+	*reinterpret_cast< uint32_t* >(output + len0) = vgetq_lane_u32(vreinterpretq_u32_u8(res), 1);
+	*reinterpret_cast< uint32_t* >(output + len1) = vgetq_lane_u32(vreinterpretq_u32_u8(res), 2);
+	*reinterpret_cast< uint32_t* >(output + len2) = vgetq_lane_u32(vreinterpretq_u32_u8(res), 3);
+	return size_t(e3 >> 32) + len2;
+}
+
+// look-up-table pruner, 16-batch; 2KB table
+template < blank_set const& set = blank_space >
+inline size_t testee12(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	uint8x16_t const vin = vld1q_u8(input);
+	uint32_t lo, hi;
+	blank_bits(blank_mask< set >(vin), lo, hi);
+
+	// the 8-lane indices, the high one raised by 8
+	uint8x16_t const piece = vcombine_u8(vcreate_u8(lut8.entry[lo]), vcreate_u8(lut8.entry[hi]));
+	uint8x16_t const index = vaddq_u8(piece, (uint8x16_t) { 0, 0, 0, 0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8 });
+	uint8x16_t const res = vqtbl1q_u8(vin, index);
+
+	size_t const len0 = 8 - __builtin_popcount(lo);
+	size_t const len1 = 8 - __builtin_popcount(hi);
+
+	*reinterpret_cast< uint64_t* >(output)        = vgetq_lane_u64(vreinterpretq_u64_u8(res), 0);
+	*reinterpret_cast< uint64_t* >(output + len0) = vgetq_lane_u64(vreinterpretq_u64_u8(res), 1);
+	return len0 + len1;
+}
+
+// look-up-table pruner, 16-batch; 40KB table
+template < blank_set const& set = blank_space >
+inline size_t testee13(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	uint8x16_t const vin = vld1q_u8(input);
+	uint32_t lo, hi;
+	blank_bits(blank_mask< set >(vin), lo, hi);
+
+	size_t const len0 = 8 - __builtin_popcount(lo);
+	size_t const len1 = 8 - __builtin_popcount(hi);
+
+	uint8x16_t const index = vorrq_u8(vld1q_u8(lut16.lo[lo]), vld1q_u8(lut16.hi[hi][len0]));
+	uint8x16_t const res = vqtbl1q_u8(vin, index);
+
+	vst1q_u8(output, res);
+	return len0 + len1;
+}
+
+#elif __x86_64__ || __i386__
+// look-up-table pruner, 16-batch; 128B table
+template < blank_set const& set = blank_space >
+TARGET_SSSE3 inline size_t testee11(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	__m128i const vin = _mm_loadu_si128(reinterpret_cast< __m128i const* >(input));
+	uint32_t const bitmask = _mm_movemask_epi8(blank_mask< set >(vin));
+
+	uint64_t const e0 = lut4.entry[bitmask       & 15];
+	uint64_t const e1 = lut4.entry[bitmask >>  4 & 15];
+	uint64_t const e2 = lut4.entry[bitmask >>  8 & 15];
+	uint64_t const e3 = lut4.entry[bitmask >> 12     ];
+
+	// the 4-lane indices, each raised by the base lane of its piece
+	__m128i const piece = _mm_setr_epi32(int(e0), int(e1), int(e2), int(e3));
+	__m128i const index = _mm_add_epi8(piece, _mm_setr_epi8(0, 0, 0, 0, 4, 4, 4, 4, 8, 8, 8, 8, 12, 12, 12, 12));
+
+	__m128i const res0 = _mm_shuffle_epi8(vin, index);
+	__m128i const res1 = _mm_shuffle_epi32(res0, 0x55);
+	__m128i const res2 = _mm_shuffle_epi32(res0, 0xee);
+	__m128i const res3 = _mm_shuffle_epi32(res0, 0xff);
+
+	size_t const len0 = size_t(e0 >> 32);
+	size_t const len1 = size_t(e1 >> 32) + len0;
+	size_t const len2 = size_t(e2 >> 32) + len1;
+
+	*reinterpret_cast< uint32_t* >(output)        = _mm_cvtsi128_si32(res0);
+	*reinterpret_cast< uint32_t* >(output + len0) = _mm_cvtsi128_si32(res1);
+	*reinterpret_cast< uint32_t* >(output + len1) = _mm_cvtsi128_si32(res2);
+	*reinterpret_cast< uint32_t* >(output + len2) = _mm_cvtsi128_si32(res3);
+	return size_t(e3 >> 32) + len2;
+}
+
+// look-up-table pruner, 16-batch; 2KB table
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t testee12(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	__m128i const vin = _mm_loadu_si128(reinterpret_cast< __m128i const* >(input));
+	uint32_t const bitmask = _mm_movemask_epi8(blank_mask< set >(vin));
+
+	// the 8-lane indices, the high one raised by 8
+	__m128i const piece0 = _mm_loadl_epi64(reinterpret_cast< __m128i const* >(lut8.entry + (bitmask & 0xff)));
+	__m128i const piece1 = _mm_loadl_epi64(reinterpret_cast< __m128i const* >(lut8.entry + (bitmask >> 8)));
+	__m128i const index = _mm_add_epi8(_mm_unpacklo_epi64(piece0, piece1), _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 8, 8, 8, 8, 8, 8, 8, 8));
+	__m128i const res = _mm_shuffle_epi8(vin, index);
+
+	size_t const len0 = 8 - _mm_popcnt_u32(bitmask & 0xff);
+
+	_mm_storel_epi64(reinterpret_cast< __m128i* >(output),        res);
+	_mm_storel_epi64(reinterpret_cast< __m128i* >(output + len0), _mm_unpackhi_epi64(res, res));
+	return 16 - _mm_popcnt_u32(bitmask);
+}
+
+// look-up-table pruner, 16-batch; 40KB table
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t testee13(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	__m128i const vin = _mm_loadu_si128(reinterpret_cast< __m128i const* >(input));
+	uint32_t const bitmask = _mm_movemask_epi8(blank_mask< set >(vin));
+
+	size_t const len0 = 8 - _mm_popcnt_u32(bitmask & 0xff);
+
+	__m128i const index = _mm_or_si128(
+		_mm_load_si128(reinterpret_cast< __m128i const* >(lut16.lo[bitmask & 0xff])),
+		_mm_load_si128(reinterpret_cast< __m128i const* >(lut16.hi[bitmask >> 8][len0])));
+	__m128i const res = _mm_shuffle_epi8(vin, index);
+
+	_mm_storeu_si128(reinterpret_cast< __m128i* >(output), res);
+	return 16 - _mm_popcnt_u32(bitmask);
+}
+
+#endif
+// generated pruners: the sorting network of a proper pruner, compiled from a comparator list by sortnet_plan_of into
+// its per-stage shuffle lanes, then unrolled stage by stage by the templates below, so the lanes fold into constants
+// as with the hand-written networks; for trying out other networks, batch sizes and vector forms without writing out
+// the stages by hand
+//
+//   testee14: testee04's 'Best version' 16-element network, on amd64 as well -- a full sort, into a single store
+//   testee15: on arm64, the same in d-form, as testee05; on amd64, testee04's four 4-element networks
+//   testee16: Batcher's odd-even merge sort of 32 elements, in q-form; arm64 only, as pshufb's table is one register
+//
+// The templates take K independent batches through the network in lockstep, stage by stage, so that a core whose
+// permutes take longer than they issue has K chains to fill the latency with, rather than one -- testee07 does that by
+// hand, for two batches:
+//
+//   testee17, 18, 19: testee04's network, on 2, 4 and 8 batches at a time
+//
+// See interleave_ways() for the K that suits the cpu.
+#if __aarch64__
+constexpr sortnet sortnet_batcher32 = sortnet_batcher(32);
+
+constexpr sortnet_plan sortnet_plan14 = sortnet_plan_of(sortnet_best16, sortnet_form_q);
+constexpr sortnet_plan sortnet_plan15 = sortnet_plan_of(sortnet_best16, sortnet_form_d);
+constexpr sortnet_plan sortnet_plan16 = sortnet_plan_of(sortnet_batcher32, sortnet_form_q);
+
+// a stage's shuffle in q-form, by its source; the risen index of up to 32 wires comes as two registers
+template < sortnet_plan const& plan, uint8_t src >
+inline uint8x16_t sortnet_gather(
+	uint8x16x2_t const st,
+	uint8_t const* const lanes) {
+
+	uint8x16_t const idx = vld1q_u8(lanes);
+	switch (src) {
+	case sortnet_src_as_is:
+		return st.val[0];
+	case sortnet_src_input:
+		return plan.wires > 16 ? vqtbl2q_u8(st, idx) : vqtbl1q_u8(st.val[0], idx);
+	case sortnet_src_min:
+		return vqtbl1q_u8(st.val[0], idx);
+	case sortnet_src_max:
+		return vqtbl1q_u8(st.val[1], idx);
+	default:
+		return vqtbl2q_u8(st, idx);
+	}
+}
+
+// ditto in d-form; the risen index comes as its two halves
+template < sortnet_plan const& plan, uint8_t src >
+inline uint8x8_t sortnet_gather(
+	uint8x8x2_t const st,
+	uint8_t const* const lanes) {
+
+	uint8x8_t const idx = vld1_u8(lanes);
+	switch (src) {
+	case sortnet_src_as_is:
+		return st.val[0];
+	case sortnet_src_input:
+		return vqtbl1_u8(vcombine_u8(st.val[0], st.val[1]), idx);
+	case sortnet_src_min:
+		return vtbl1_u8(st.val[0], idx);
+	case sortnet_src_max:
+		return vtbl1_u8(st.val[1], idx);
+	default:
+		return vtbl2_u8(st, idx);
+	}
+}
+
+// stages s and on of a plan, over K batches: st holds the min and max vectors of the stage before, or the risen index
+// for the first; the last leaves the sorted index in st, its lanes in order across the two registers
+template < sortnet_plan const& plan, size_t K, size_t s, bool last = s == plan.stages >
+struct sortnet_stages {
+	static void index(uint8x16x2_t (&st)[K]) {
+		for (size_t k = 0; k < K; ++k) {
+			uint8x16_t const a = sortnet_gather< plan, plan.src_a[s] >(st[k], plan.a[s]);
+			uint8x16_t const b = sortnet_gather< plan, plan.src_b[s] >(st[k], plan.b[s]);
+			st[k].val[0] = vminq_u8(a, b);
+			st[k].val[1] = vmaxq_u8(a, b);
+		}
+		sortnet_stages< plan, K, s + 1 >::index(st);
+	}
+
+	static void index(uint8x8x2_t (&st)[K]) {
+		for (size_t k = 0; k < K; ++k) {
+			uint8x8_t const a = sortnet_gather< plan, plan.src_a[s] >(st[k], plan.a[s]);
+			uint8x8_t const b = sortnet_gather< plan, plan.src_b[s] >(st[k], plan.b[s]);
+			st[k].val[0] = vmin_u8(a, b);
+			st[k].val[1] = vmax_u8(a, b);
+		}
+		sortnet_stages< plan, K, s + 1 >::index(st);
+	}
+};
+
+template < sortnet_plan const& plan, size_t K, size_t s >
+struct sortnet_stages< plan, K, s, true > {
+	static void index(uint8x16x2_t (&st)[K]) {
+		for (size_t k = 0; k < K; ++k) {
+			uint8x16_t const lo = vqtbl2q_u8(st[k], vld1q_u8(plan.index));
+			uint8x16_t const hi = vqtbl2q_u8(st[k], vld1q_u8(plan.index + 16));
+			st[k].val[0] = lo;
+			st[k].val[1] = hi;
+		}
+	}
+
+	static void index(uint8x8x2_t (&st)[K]) {
+		for (size_t k = 0; k < K; ++k) {
+			uint8x16_t const idx = vqtbl1q_u8(vcombine_u8(st[k].val[0], st[k].val[1]), vld1q_u8(plan.index));
+			st[k].val[0] = vget_low_u8(idx);
+			st[k].val[1] = vget_high_u8(idx);
+		}
+	}
+};
+
+// generated pruner, 16K-batch; a full sort of 16 wires in q-form, over K batches at a time
+template < sortnet_plan const& plan, size_t K = 1, blank_set const& set = blank_space >
+inline size_t testee_net16(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	static_assert(plan.ok && 16 == plan.wires && 16 == plan.run && sortnet_form_q == plan.half, "unfit plan");
+
+	uint8x16_t vin[K];
+	uint8x16_t bmask[K];
+	uint8x16x2_t st[K];
+
+	for (size_t k = 0; k < K; ++k) {
+		vin[k] = vld1q_u8(input + 16 * k);
+		bmask[k] = blank_mask< set >(vin[k]);
+		st[k].val[0] = vorrq_u8(bmask[k], (uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 });
+	}
+
+	sortnet_stages< plan, K, 0 >::index(st);
+
+	size_t pos = 0;
+	for (size_t k = 0; k < K; ++k) {
+		vst1q_u8(output + pos, vqtbl1q_u8(vin[k], st[k].val[0]));
+		pos += sizeof(uint8x16_t) + int8_t(vaddvq_u8(bmask[k]));
+	}
+	return pos;
+}
+
+// generated pruner, 16K-batch; a full sort of 16 wires in d-form, over K batches at a time
+template < sortnet_plan const& plan, size_t K = 1, blank_set const& set = blank_space >
+inline size_t testee_net16d(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	static_assert(plan.ok && 16 == plan.wires && 16 == plan.run && sortnet_form_d == plan.half, "unfit plan");
+
+	uint8x16_t vin[K];
+	uint8x16_t bmask[K];
+	uint8x8x2_t st[K];
+
+	for (size_t k = 0; k < K; ++k) {
+		vin[k] = vld1q_u8(input + 16 * k);
+		bmask[k] = blank_mask< set >(vin[k]);
+
+		uint8x16_t const risen = vorrq_u8(bmask[k], (uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 });
+		st[k].val[0] = vget_low_u8(risen);
+		st[k].val[1] = vget_high_u8(risen);
+	}
+
+	sortnet_stages< plan, K, 0 >::index(st);
+
+	size_t pos = 0;
+	for (size_t k = 0; k < K; ++k) {
+		vst1q_u8(output + pos, vqtbl1q_u8(vin[k], vcombine_u8(st[k].val[0], st[k].val[1])));
+		pos += sizeof(uint8x16_t) + int8_t(vaddvq_u8(bmask[k]));
+	}
+	return pos;
+}
+
+// generated pruner, 32-batch; a full sort of 32 wires in q-form, sampling both input registers
+template < sortnet_plan const& plan, blank_set const& set = blank_space >
+inline size_t testee_net32(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	static_assert(plan.ok && 32 == plan.wires && 32 == plan.run && sortnet_form_q == plan.half, "unfit plan");
+
+	uint8x16x2_t const vin = { { vld1q_u8(input), vld1q_u8(input + 16) } };
+	uint8x16_t const bmask0 = blank_mask< set >(vin.val[0]);
+	uint8x16_t const bmask1 = blank_mask< set >(vin.val[1]);
+
+	uint8x16x2_t st[1] = { { {
+		vorrq_u8(bmask0, (uint8x16_t) {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 }),
+		vorrq_u8(bmask1, (uint8x16_t) { 16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31 }) } } };
+
+	sortnet_stages< plan, 1, 0 >::index(st);
+
+	vst1q_u8(output, vqtbl2q_u8(vin, st[0].val[0]));
+	vst1q_u8(output + 16, vqtbl2q_u8(vin, st[0].val[1]));
+	return sizeof(vin) + int8_t(vaddvq_u8(bmask0)) + int8_t(vaddvq_u8(bmask1));
+}
+
+#elif __x86_64__ || __i386__
+constexpr sortnet_plan sortnet_plan14 = sortnet_plan_of(sortnet_best16, sortnet_form_ssse3);
+constexpr sortnet_plan sortnet_plan15 = sortnet_plan_of(sortnet_quad16, sortnet_form_ssse3);
+
+// a stage's shuffle, by its source
+template < uint8_t src >
+TARGET_SSSE3 inline __m128i sortnet_gather(
+	__m128i const min,
+	__m128i const max,
+	uint8_t const* const lanes) {
+
+	__m128i const idx = _mm_load_si128(reinterpret_cast< __m128i const* >(lanes));
+	switch (src) {
+	case sortnet_src_as_is:
+		return min;
+	case sortnet_src_input:
+	case sortnet_src_min:
+		return _mm_shuffle_epi8(min, idx);
+	case sortnet_src_max:
+		return _mm_shuffle_epi8(max, idx);
+	default:
+		return _mm_shuffle_epi8(_mm_unpacklo_epi64(min, max), idx);
+	}
+}
+
+// stages s and on of a plan, over K batches: min and max hold the min and max vectors of the stage before, or the
+// risen index for the first; the last leaves the sorted index in min
+template < sortnet_plan const& plan, size_t K, size_t s, bool last = s == plan.stages >
+struct sortnet_stages {
+	TARGET_SSSE3 static void index(
+		__m128i (&min)[K],
+		__m128i (&max)[K]) {
+
+		for (size_t k = 0; k < K; ++k) {
+			__m128i const a = sortnet_gather< plan.src_a[s] >(min[k], max[k], plan.a[s]);
+			__m128i const b = sortnet_gather< plan.src_b[s] >(min[k], max[k], plan.b[s]);
+			min[k] = _mm_min_epu8(a, b);
+			max[k] = _mm_max_epu8(a, b);
+		}
+		sortnet_stages< plan, K, s + 1 >::index(min, max);
+	}
+};
+
+template < sortnet_plan const& plan, size_t K, size_t s >
+struct sortnet_stages< plan, K, s, true > {
+	TARGET_SSSE3 static void index(
+		__m128i (&min)[K],
+		__m128i (&max)[K]) {
+
+		__m128i const idx = _mm_load_si128(reinterpret_cast< __m128i const* >(plan.index));
+		for (size_t k = 0; k < K; ++k)
+			min[k] = _mm_shuffle_epi8(_mm_unpacklo_epi64(min[k], max[k]), idx);
+	}
+};
+
+// store a batch sampled by the sorted index, each run of the plan at the count of non-blanks in the runs before it,
+// as with testee04; returns the count of non-blanks
+template < sortnet_plan const& plan >
+TARGET_SSSE3_POPCNT inline size_t sortnet_store(
+	uint8_t* const output,
+	__m128i const res,
+	__m128i const bmask) {
+
+	static_assert(4 == plan.run || 8 == plan.run || 16 == plan.run, "unfit plan");
+	uint32_t const bitmask = ~_mm_movemask_epi8(bmask);
+
+	if (16 == plan.run)
+		_mm_storeu_si128(reinterpret_cast< __m128i* >(output), res);
+
+	if (8 == plan.run) {
+		uint32_t const len0 = _mm_popcnt_u32(bitmask & 0xff);
+
+		_mm_storel_epi64(reinterpret_cast< __m128i* >(output),        res);
+		_mm_storel_epi64(reinterpret_cast< __m128i* >(output + len0), _mm_unpackhi_epi64(res, res));
+	}
+
+	if (4 == plan.run) {
+		uint32_t const len0 = _mm_popcnt_u32(bitmask & 0x00f);
+		uint32_t const len1 = _mm_popcnt_u32(bitmask & 0x0ff);
+		uint32_t const len2 = _mm_popcnt_u32(bitmask & 0xfff);
+
+		*reinterpret_cast< uint32_t* >(output)        = _mm_cvtsi128_si32(res);
+		*reinterpret_cast< uint32_t* >(output + len0) = _mm_cvtsi128_si32(_mm_shuffle_epi32(res, 0x55));
+		*reinterpret_cast< uint32_t* >(output + len1) = _mm_cvtsi128_si32(_mm_shuffle_epi32(res, 0xee));
+		*reinterpret_cast< uint32_t* >(output + len2) = _mm_cvtsi128_si32(_mm_shuffle_epi32(res, 0xff));
+	}
+	return _mm_popcnt_u32(bitmask & 0xffff);
+}
+
+// generated pruner, 16K-batch; 16 wires, over K batches at a time
+template < sortnet_plan const& plan, size_t K = 1, blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t testee_net16(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	static_assert(plan.ok && 16 == plan.wires && sortnet_form_ssse3 == plan.half, "unfit plan");
+
+	__m128i vin[K];
+	__m128i bmask[K];
+	__m128i min[K];
+	__m128i max[K];
+
+	for (size_t k = 0; k < K; ++k) {
+		vin[k] = _mm_loadu_si128(reinterpret_cast< __m128i const* >(input + 16 * k));
+		bmask[k] = blank_mask< set >(vin[k]);
+		min[k] = max[k] = _mm_or_si128(bmask[k], _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+	}
+
+	sortnet_stages< plan, K, 0 >::index(min, max);
+
+	size_t pos = 0;
+	for (size_t k = 0; k < K; ++k)
+		pos += sortnet_store< plan >(output + pos, _mm_shuffle_epi8(vin[k], min[k]), bmask[k]);
+
+	return pos;
+}
+
+#endif
+// skimming pruners -- long stretches of input with no blanks (base64, hex dumps) or nothing but blanks (padding)
+// take a pruner's full network for nothing; a skimming pruner classifies each 64-char block by its blank masks first,
+// copies blocks with no blanks as they are, drops blocks of blanks only, and leaves the rest to its pruner. The class
+// is one well-predicted branch on text that stays mixed, or stays clean, for a few blocks at a time; densities that
+// flip the class block by block pay a mispredict per flip -- see the density sweep in README.md
+#if __aarch64__
+// skimming pruner, 64-batch, over a pruner of the given batch
+template < size_t batch, size_t (&testee)(uint8_t const*, uint8_t*), blank_set const& set = blank_space >
+inline size_t skim64(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	uint8x16x4_t const vin = vld1q_u8_x4(input);
+	uint8x16_t const bmask0 = blank_mask< set >(vin.val[0]);
+	uint8x16_t const bmask1 = blank_mask< set >(vin.val[1]);
+	uint8x16_t const bmask2 = blank_mask< set >(vin.val[2]);
+	uint8x16_t const bmask3 = blank_mask< set >(vin.val[3]);
+
+	uint8x16_t const any = vorrq_u8(vorrq_u8(bmask0, bmask1), vorrq_u8(bmask2, bmask3));
+	uint8x16_t const all = vandq_u8(vandq_u8(bmask0, bmask1), vandq_u8(bmask2, bmask3));
+
+	if (0 == vmaxvq_u8(any)) {
+		vst1q_u8_x4(output, vin);
+		return sizeof(vin);
+	}
+	if (0xff == vminvq_u8(all))
+		return 0;
+
+	size_t pos = 0;
+	for (size_t i = 0; i < sizeof(vin); i += batch)
+		pos += testee(input + i, output + pos);
+
+	return pos;
+}
+
+#elif __x86_64__ || __i386__
+// skimming pruner, 64-batch, over a pruner of the given batch
+template < size_t batch, size_t (&testee)(uint8_t const*, uint8_t*), blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t skim64(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	__m128i const* const src = reinterpret_cast< __m128i const* >(input);
+	__m128i const vin0 = _mm_loadu_si128(src + 0);
+	__m128i const vin1 = _mm_loadu_si128(src + 1);
+	__m128i const vin2 = _mm_loadu_si128(src + 2);
+	__m128i const vin3 = _mm_loadu_si128(src + 3);
+	__m128i const bmask0 = blank_mask< set >(vin0);
+	__m128i const bmask1 = blank_mask< set >(vin1);
+	__m128i const bmask2 = blank_mask< set >(vin2);
+	__m128i const bmask3 = blank_mask< set >(vin3);
+
+	uint32_t const any = _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(bmask0, bmask1), _mm_or_si128(bmask2, bmask3)));
+	uint32_t const all = _mm_movemask_epi8(_mm_and_si128(_mm_and_si128(bmask0, bmask1), _mm_and_si128(bmask2, bmask3)));
+
+	if (0 == any) {
+		__m128i* const dst = reinterpret_cast< __m128i* >(output);
+		_mm_storeu_si128(dst + 0, vin0);
+		_mm_storeu_si128(dst + 1, vin1);
+		_mm_storeu_si128(dst + 2, vin2);
+		_mm_storeu_si128(dst + 3, vin3);
+		return 64;
+	}
+	if (0xffff == all)
+		return 0;
+
+	size_t pos = 0;
+	for (size_t i = 0; i < 64; i += batch)
+		pos += testee(input + i, output + pos);
+
+	return pos;
+}
+
+#if __x86_64__
+// skimming pruner, 64-batch, over an avx2 pruner of the given batch
+template < size_t batch, size_t (&testee)(uint8_t const*, uint8_t*), blank_set const& set = blank_space >
+TARGET_AVX2 inline size_t skim64_avx2(
+	uint8_t const* const input,
+	uint8_t* const output) {
+
+	__m256i const* const src = reinterpret_cast< __m256i const* >(input);
+	__m256i const vin0 = _mm256_loadu_si256(src + 0);
+	__m256i const vin1 = _mm256_loadu_si256(src + 1);
+	__m256i const bmask0 = blank_mask< set >(vin0);
+	__m256i const bmask1 = blank_mask< set >(vin1);
+
+	uint32_t const any = _mm256_movemask_epi8(_mm256_or_si256(bmask0, bmask1));
+	uint32_t const all = _mm256_movemask_epi8(_mm256_and_si256(bmask0, bmask1));
+
+	if (0 == any) {
+		__m256i* const dst = reinterpret_cast< __m256i* >(output);
+		_mm256_storeu_si256(dst + 0, vin0);
+		_mm256_storeu_si256(dst + 1, vin1);
+		return 64;
+	}
+	if (0xffffffff == all)
+		return 0;
+
+	size_t pos = 0;
+	for (size_t i = 0; i < 64; i += batch)
+		pos += testee(input + i, output + pos);
+
+	return pos;
+}
+
+#endif
+#endif
+// bulk pruner: run a batch pruner over an arbitrary-length buffer; returns the count of non-blanks written to out;
+// batch pruners store within the batch-sized window at their write cursor, so they are fed directly only while that
+// window fits in cap, and batch by batch off-line past that point; as the write cursor never overtakes the read
+// cursor, a cap of len needs no off-line batches but the tail; a cap of the exact count of non-blanks guarantees no
+// stores past them; only the proper, the look-up-table, the generated and the skimming pruners (testee00, 04 - 09,
+// 11 - 21) are eligible
+//
+// out may equal in: every pruner loads its batch in full before it stores, and those stores stay within the
+// batch-sized window at the write cursor, which is at or behind the read cursor, so they overwrite nothing but chars
+// already loaded; the tail is copied off-line before it is pruned
+//
+// set is the blank set the pruner was built for, which the tail is padded with; utf-8 sets have every batch
+// canonicalized off-line before it is pruned -- see utf8_canon -- which keeps the above, as a batch's look-ahead is
+// loaded before the batch is stored
+template < size_t batch, size_t (&testee)(uint8_t const*, uint8_t*), blank_set const& set >
+__attribute__ ((always_inline)) inline size_t prune_bulk(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	if (set.utf8) {
+		utf8_state st = utf8_init();
+		uint8_t tmp_in[batch] __attribute__ ((aligned(64)));
+		uint8_t tmp_out[batch] __attribute__ ((aligned(64)));
+		size_t pos = 0;
+
+		for (size_t i = 0; i < len; i += batch) {
+			size_t const n = len - i < batch ? len - i : batch;
+			utf8_canon< batch, set >(in + i, n, len - i, tmp_in, st);
+
+			// an empty set keeps the padding of the tail, at the end of the batch's output
+			bool const direct = pos + batch <= cap;
+			size_t const kept = testee(tmp_in, direct ? out + pos : tmp_out) - (set.empty ? batch - n : 0);
+
+			if (!direct)
+				memcpy(out + pos, tmp_out, kept);
+			pos += kept;
+		}
+		return pos;
+	}
+
+	size_t i = 0, pos = 0;
+	for (; i + batch <= len && pos + batch <= cap; i += batch)
+		pos += testee(in + i, out + pos);
+
+	uint8_t tmp_in[batch] __attribute__ ((aligned(64)));
+	uint8_t tmp_out[batch] __attribute__ ((aligned(64)));
+
+	for (; i + batch <= len; i += batch) {
+		size_t const kept = testee(in + i, tmp_out);
+		memcpy(out + pos, tmp_out, kept);
+		pos += kept;
+	}
+
+	// pad the tail to a full batch with blanks and prune it off-line as well; an empty set keeps the padding, at the
+	// end of the batch's output
+	if (i < len) {
+		memset(tmp_in, set.pad, sizeof(tmp_in));
+		memcpy(tmp_in, in + i, len - i);
+
+		size_t const kept = testee(tmp_in, tmp_out) - (set.empty ? batch - (len - i) : 0);
+		memcpy(out + pos, tmp_out, kept);
+		pos += kept;
+	}
+	return pos;
+}
+
+// bulk pruner entry points, one per proper pruner; these carry the isa of their pruner so the latter inlines
+typedef size_t (*prune_fn)(uint8_t const* in, size_t len, uint8_t* out, size_t cap);
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee00(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee00< set >, set >(in, len, out, cap);
+}
+
+#if __aarch64__
+template < blank_set const& set = blank_space >
+inline size_t prune_testee04(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee04< set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee05(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee05< set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee06(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee06< set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee07(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 32, testee07< set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee11(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee11< set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee12(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee12< set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee13(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee13< set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee14(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee_net16< sortnet_plan14, 1, set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee15(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee_net16d< sortnet_plan15, 1, set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee16(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 32, testee_net32< sortnet_plan16, set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee17(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 32, testee_net16< sortnet_plan14, 2, set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee18(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 64, testee_net16< sortnet_plan14, 4, set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee19(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 128, testee_net16< sortnet_plan14, 8, set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee20(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 64, skim64< 16, testee04< set >, set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+inline size_t prune_testee21(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 64, skim64< 32, testee07< set >, set >, set >(in, len, out, cap);
+}
+
+#if defined(__ARM_FEATURE_SVE)
+template < blank_set const& set = blank_space >
+inline size_t prune_testee08(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 64, testee08< set >, set >(in, len, out, cap);
+}
+
+// testee10 takes the tail by predication rather than by prune_bulk's blank-padded batch, and never stores past the
+// non-blanks, so any cap holds; utf-8 sets need fixed batches for their canonicalization, so those go by testee07
+template < blank_set const& set = blank_space >
+inline size_t prune_testee10(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	if (set.utf8)
+		return prune_bulk< 32, testee07< set >, set >(in, len, out, cap);
+
+	size_t pos = 0;
+	for (size_t i = 0; i < len; i += svcntb())
+		pos += testee10< set >(in + i, out + pos, svwhilelt_b8_u64(i, len));
+
+	return pos;
+}
+
+#endif
+#elif __x86_64__ || __i386__
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t prune_testee04(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee04< set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t prune_testee05(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee05< set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+TARGET_SSSE3 inline size_t prune_testee11(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee11< set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t prune_testee12(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee12< set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t prune_testee13(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee13< set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t prune_testee14(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee_net16< sortnet_plan14, 1, set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t prune_testee15(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 16, testee_net16< sortnet_plan15, 1, set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t prune_testee17(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 32, testee_net16< sortnet_plan15, 2, set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t prune_testee18(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 64, testee_net16< sortnet_plan15, 4, set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t prune_testee19(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 128, testee_net16< sortnet_plan15, 8, set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t prune_testee20(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 64, skim64< 16, testee04< set >, set >, set >(in, len, out, cap);
+}
+
+#if __x86_64__
+template < blank_set const& set = blank_space >
+TARGET_AVX2 inline size_t prune_testee07(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 32, testee07< set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+TARGET_AVX2 inline size_t prune_testee09(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 64, testee09< set >, set >(in, len, out, cap);
+}
+
+template < blank_set const& set = blank_space >
+TARGET_AVX2 inline size_t prune_testee21(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const cap) {
+
+	return prune_bulk< 64, skim64_avx2< 32, testee07< set >, set >, set >(in, len, out, cap);
+}
+
+#endif
+#endif
+// runtime isa checks
+inline bool cpu_any() {
+	return true;
+}
+
+#if __aarch64__
+#if defined(__ARM_FEATURE_SVE)
+inline bool cpu_has_sve512() {
+#if __linux__
+	if (!(getauxval(AT_HWCAP) & HWCAP_SVE))
+		return false;
+#endif
+	return svcntb() == 64; // testee08 assumes exactly sve512
+}
+
+inline bool cpu_has_sve() {
+#if __linux__
+	return getauxval(AT_HWCAP) & HWCAP_SVE;
+#else
+	return true;
+#endif
+}
+
+#endif
+// cpu identity as MIDR_EL1 implementer and part number, (implementer << 12 | part); 0 when unknown
+inline uint32_t cpu_part() {
+#if __APPLE__
+	return 0x61 << 12; // apple silicon, part unknown
+#elif __linux__
+	if (!(getauxval(AT_HWCAP) & HWCAP_CPUID))
+		return 0;
+
+	// trapped and emulated by the kernel; reports the core we are on at the time -- on big.LITTLE that is a coin toss
+	uint64_t midr;
+	asm volatile ("mrs %0, midr_el1" : "=r" (midr));
+	return uint32_t(midr >> 24 & 0xff) << 12 | uint32_t(midr >> 4 & 0xfff);
+#else
+	return 0;
+#endif
+}
+
+#elif __x86_64__ || __i386__
+inline bool cpu_has_ssse3() {
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("ssse3");
+}
+
+inline bool cpu_has_ssse3_popcnt() {
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("ssse3") && __builtin_cpu_supports("popcnt");
+}
+
+inline bool cpu_has_avx2_popcnt() {
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt");
+}
+
+// cpu identity as vendor and display family and model, (vendor << 16 | family << 8 | model); vendor: 1 -- intel, 2 -- amd
+inline uint32_t cpu_part() {
+	uint32_t eax, ebx, ecx, edx;
+	if (!__get_cpuid(0, &eax, &ebx, &ecx, &edx))
+		return 0;
+
+	uint32_t const vendor =
+		ebx == 0x756e6547 ? 1 : // "GenuineIntel"
+		ebx == 0x68747541 ? 2 : // "AuthenticAMD"
+		0;
+
+	__get_cpuid(1, &eax, &ebx, &ecx, &edx);
+	uint32_t family = eax >> 8 & 0xf;
+	uint32_t model = eax >> 4 & 0xf;
+
+	if (family == 0xf)
+		family += eax >> 20 & 0xff;
+	if (family >= 0x6)
+		model |= (eax >> 16 & 0xf) << 4;
+
+	return vendor << 16 | family << 8 | model;
+}
+
+#endif
+// permute latency probe, after lattest: the time of a chain of 8 permutes, each taking the result of the one before,
+// and of 8 independent ones, repeated; the latter are as many as the interleaved pruners take batches at most
+enum {
+	interleave_max = 8,
+	interleave_reps = 1 << 12,
+	interleave_runs = 8 // best of
+};
+
+inline uint64_t interleave_ns() {
+	timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return uint64_t(ts.tv_sec) * 1000000000 + uint64_t(ts.tv_nsec);
+}
+
+#if __aarch64__
+inline uint64_t interleave_chain(bool const coissue) {
+	uint64_t const start = interleave_ns();
+
+	for (size_t i = 0; i < interleave_reps; ++i)
+		if (coissue)
+			asm volatile (
+				"tbl v17.16b, {v1.16b}, v0.16b\n\t"
+				"tbl v18.16b, {v2.16b}, v0.16b\n\t"
+				"tbl v19.16b, {v3.16b}, v0.16b\n\t"
+				"tbl v20.16b, {v4.16b}, v0.16b\n\t"
+				"tbl v21.16b, {v5.16b}, v0.16b\n\t"
+				"tbl v22.16b, {v6.16b}, v0.16b\n\t"
+				"tbl v23.16b, {v7.16b}, v0.16b\n\t"
+				"tbl v24.16b, {v8.16b}, v0.16b"
+				: : : "v17", "v18", "v19", "v20", "v21", "v22", "v23", "v24");
+		else
+			asm volatile (
+				"tbl v17.16b, {v24.16b}, v0.16b\n\t"
+				"tbl v18.16b, {v17.16b}, v0.16b\n\t"
+				"tbl v19.16b, {v18.16b}, v0.16b\n\t"
+				"tbl v20.16b, {v19.16b}, v0.16b\n\t"
+				"tbl v21.16b, {v20.16b}, v0.16b\n\t"
+				"tbl v22.16b, {v21.16b}, v0.16b\n\t"
+				"tbl v23.16b, {v22.16b}, v0.16b\n\t"
+				"tbl v24.16b, {v23.16b}, v0.16b"
+				: : : "v17", "v18", "v19", "v20", "v21", "v22", "v23", "v24");
+
+	return interleave_ns() - start;
+}
+
+#elif __x86_64__ || __i386__
+inline uint64_t interleave_chain(bool const coissue) {
+	uint64_t const start = interleave_ns();
+
+	// xmm0 - 7 only, for i386; the independent permutes are 8 chains, each a permute long per rep
+	for (size_t i = 0; i < interleave_reps; ++i)
+		if (coissue)
+			asm volatile (
+				"pshufb %%xmm0, %%xmm0\n\t"
+				"pshufb %%xmm1, %%xmm1\n\t"
+				"pshufb %%xmm2, %%xmm2\n\t"
+				"pshufb %%xmm3, %%xmm3\n\t"
+				"pshufb %%xmm4, %%xmm4\n\t"
+				"pshufb %%xmm5, %%xmm5\n\t"
+				"pshufb %%xmm6, %%xmm6\n\t"
+				"pshufb %%xmm7, %%xmm7"
+				: : : "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7");
+		else
+			asm volatile (
+				"pshufb %%xmm7, %%xmm0\n\t"
+				"pshufb %%xmm0, %%xmm1\n\t"
+				"pshufb %%xmm1, %%xmm2\n\t"
+				"pshufb %%xmm2, %%xmm3\n\t"
+				"pshufb %%xmm3, %%xmm4\n\t"
+				"pshufb %%xmm4, %%xmm5\n\t"
+				"pshufb %%xmm5, %%xmm6\n\t"
+				"pshufb %%xmm6, %%xmm7"
+				: : : "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7");
+
+	return interleave_ns() - start;
+}
+
+#endif
+// count of batches the interleaved pruners should take at a time on the cpu we run on: a permute's latency over its
+// issue interval, which is how many independent permute chains it takes to keep the permute unit busy, rounded up to
+// a power of two and capped at interleave_max; probed once per process, at a cost of a fraction of a millisecond
+inline size_t interleave_probe() {
+#if __aarch64__ || __x86_64__ || __i386__
+#if __x86_64__ || __i386__
+	if (!cpu_has_ssse3_popcnt())
+		return 1;
+
+#endif
+	uint64_t dep = ~uint64_t(0), ind = ~uint64_t(0);
+	for (size_t i = 0; i < interleave_runs; ++i) {
+		uint64_t const d = interleave_chain(false);
+		uint64_t const c = interleave_chain(true);
+		dep = d < dep ? d : dep;
+		ind = c < ind ? c : ind;
+	}
+
+	// a quarter of slack against the loop overhead and timer noise
+	size_t ways = 1;
+	while (ways < size_t(interleave_max) && 4 * dep > (4 * ways + 1) * ind)
+		ways *= 2;
+
+	return ways;
+
+#else
+	return 1;
+
+#endif
+}
+
+inline size_t interleave_ways() {
+	static size_t const ways = interleave_probe();
+	return ways;
+}
+
+// count of blanks in the whole 64-char steps of a buffer, by the blank masks of the pruners; blanks are tallied per
+// lane for up to 63 steps before the lane tallies get summed up; advances i past the steps
+#if __aarch64__
+template < blank_set const& set >
+inline size_t count_blanks_simd(
+	uint8_t const* const in,
+	size_t const len,
+	size_t& i) {
+
+	size_t blanks = 0;
+	while (i + 64 <= len) {
+		size_t const end = i + 63 * 64 < len ? i + 63 * 64 : len;
+		uint8x16_t acc = vdupq_n_u8(0);
+
+		for (; i + 64 <= end; i += 64) {
+			acc = vsubq_u8(acc, blank_mask< set >(vld1q_u8(in + i +  0)));
+			acc = vsubq_u8(acc, blank_mask< set >(vld1q_u8(in + i + 16)));
+			acc = vsubq_u8(acc, blank_mask< set >(vld1q_u8(in + i + 32)));
+			acc = vsubq_u8(acc, blank_mask< set >(vld1q_u8(in + i + 48)));
+		}
+		blanks += vaddlvq_u8(acc);
+	}
+	return blanks;
+}
+
+#elif __x86_64__ || __i386__
+// sets classified by a compare need just sse2
+template < blank_set const& set >
+inline size_t count_blanks_sse2(
+	uint8_t const* const in,
+	size_t const len,
+	size_t& i) {
+
+	size_t blanks = 0;
+	while (i + 64 <= len) {
+		size_t const end = i + 63 * 64 < len ? i + 63 * 64 : len;
+		__m128i acc = _mm_setzero_si128();
+
+		for (; i + 64 <= end; i += 64) {
+			__m128i const* const src = reinterpret_cast< __m128i const* >(in + i);
+			acc = _mm_sub_epi8(acc, blank_mask_sse2< set >(_mm_loadu_si128(src + 0)));
+			acc = _mm_sub_epi8(acc, blank_mask_sse2< set >(_mm_loadu_si128(src + 1)));
+			acc = _mm_sub_epi8(acc, blank_mask_sse2< set >(_mm_loadu_si128(src + 2)));
+			acc = _mm_sub_epi8(acc, blank_mask_sse2< set >(_mm_loadu_si128(src + 3)));
+		}
+		__m128i const sum = _mm_sad_epu8(acc, _mm_setzero_si128());
+		blanks += _mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(sum, sum));
+	}
+	return blanks;
+}
+
+template < blank_set const& set >
+TARGET_SSSE3 inline size_t count_blanks_ssse3(
+	uint8_t const* const in,
+	size_t const len,
+	size_t& i) {
+
+	size_t blanks = 0;
+	while (i + 64 <= len) {
+		size_t const end = i + 63 * 64 < len ? i + 63 * 64 : len;
+		__m128i acc = _mm_setzero_si128();
+
+		for (; i + 64 <= end; i += 64) {
+			__m128i const* const src = reinterpret_cast< __m128i const* >(in + i);
+			acc = _mm_sub_epi8(acc, blank_mask< set >(_mm_loadu_si128(src + 0)));
+			acc = _mm_sub_epi8(acc, blank_mask< set >(_mm_loadu_si128(src + 1)));
+			acc = _mm_sub_epi8(acc, blank_mask< set >(_mm_loadu_si128(src + 2)));
+			acc = _mm_sub_epi8(acc, blank_mask< set >(_mm_loadu_si128(src + 3)));
+		}
+		__m128i const sum = _mm_sad_epu8(acc, _mm_setzero_si128());
+		blanks += _mm_cvtsi128_si32(sum) + _mm_cvtsi128_si32(_mm_unpackhi_epi64(sum, sum));
+	}
+	return blanks;
+}
+
+#endif
+// count of non-blanks in an arbitrary-length buffer, by the classification of chars alone
+template < blank_set const& set >
+inline size_t count_nonblanks_chars(
+	uint8_t const* const in,
+	size_t const len) {
+
+	size_t i = 0, blanks = 0;
+
+#if __aarch64__
+	blanks = count_blanks_simd< set >(in, len, i);
+
+#elif __x86_64__ || __i386__
+	if (set.cmp != blank_cmp_lookup)
+		blanks = count_blanks_sse2< set >(in, len, i);
+	else if (cpu_has_ssse3())
+		blanks = count_blanks_ssse3< set >(in, len, i);
+
+#endif
+	for (; i < len; ++i)
+		blanks += is_blank< set >(in[i]) ? 1 : 0;
+
+	return len - blanks;
+}
+
+// count of non-blanks in an arbitrary-length buffer; utf-8 sets count the canonicalized buffer, 64 chars at a time
+template < blank_set const& set = blank_space >
+inline size_t count_nonblanks(
+	uint8_t const* const in,
+	size_t const len) {
+
+	if (!set.utf8)
+		return count_nonblanks_chars< set >(in, len);
+
+	utf8_state st = utf8_init();
+	uint8_t tmp[64] __attribute__ ((aligned(64)));
+	size_t kept = 0;
+
+	for (size_t i = 0; i < len; i += sizeof(tmp)) {
+		size_t const n = len - i < sizeof(tmp) ? len - i : sizeof(tmp);
+		utf8_canon< sizeof(tmp), set >(in + i, n, len - i, tmp, st);
+		kept += count_nonblanks_chars< set >(tmp, n);
+	}
+	return kept;
+}
+
+// registry of all proper pruners built into this binary, for the given blank set
+struct pruner {
+	char const* name;
+	size_t batch; // input granularity, in chars
+	prune_fn prune;
+	bool (*supported)();
+	size_t (*count)(uint8_t const* in, size_t len); // count_nonblanks of the same blank set
+};
+
+template < blank_set const& set = blank_space >
+inline pruner const* get_pruners(size_t& count) {
+	static pruner const pruners[] = {
+		{ "testee00", 16, prune_testee00< set >, cpu_any, count_nonblanks< set > },
+#if __aarch64__
+		{ "testee04", 16, prune_testee04< set >, cpu_any, count_nonblanks< set > },
+		{ "testee05", 16, prune_testee05< set >, cpu_any, count_nonblanks< set > },
+		{ "testee06", 16, prune_testee06< set >, cpu_any, count_nonblanks< set > },
+		{ "testee07", 32, prune_testee07< set >, cpu_any, count_nonblanks< set > },
+		{ "testee11", 16, prune_testee11< set >, cpu_any, count_nonblanks< set > },
+		{ "testee12", 16, prune_testee12< set >, cpu_any, count_nonblanks< set > },
+		{ "testee13", 16, prune_testee13< set >, cpu_any, count_nonblanks< set > },
+		{ "testee14", 16, prune_testee14< set >, cpu_any, count_nonblanks< set > },
+		{ "testee15", 16, prune_testee15< set >, cpu_any, count_nonblanks< set > },
+		{ "testee16", 32, prune_testee16< set >, cpu_any, count_nonblanks< set > },
+		{ "testee17", 32, prune_testee17< set >, cpu_any, count_nonblanks< set > },
+		{ "testee18", 64, prune_testee18< set >, cpu_any, count_nonblanks< set > },
+		{ "testee19", 128, prune_testee19< set >, cpu_any, count_nonblanks< set > },
+		{ "testee20", 64, prune_testee20< set >, cpu_any, count_nonblanks< set > },
+		{ "testee21", 64, prune_testee21< set >, cpu_any, count_nonblanks< set > },
+#if defined(__ARM_FEATURE_SVE)
+		{ "testee08", 64, prune_testee08< set >, cpu_has_sve512, count_nonblanks< set > },
+		{ "testee10", 16, prune_testee10< set >, cpu_has_sve, count_nonblanks< set > },   // any multiple of 16, actually
+#endif
+#elif __x86_64__ || __i386__
+		{ "testee04", 16, prune_testee04< set >, cpu_has_ssse3_popcnt, count_nonblanks< set > },
+		{ "testee05", 16, prune_testee05< set >, cpu_has_ssse3_popcnt, count_nonblanks< set > },
+		{ "testee11", 16, prune_testee11< set >, cpu_has_ssse3,        count_nonblanks< set > },
+		{ "testee12", 16, prune_testee12< set >, cpu_has_ssse3_popcnt, count_nonblanks< set > },
+		{ "testee13", 16, prune_testee13< set >, cpu_has_ssse3_popcnt, count_nonblanks< set > },
+		{ "testee14", 16, prune_testee14< set >, cpu_has_ssse3_popcnt, count_nonblanks< set > },
+		{ "testee15", 16, prune_testee15< set >, cpu_has_ssse3_popcnt, count_nonblanks< set > },
+		{ "testee17", 32, prune_testee17< set >, cpu_has_ssse3_popcnt, count_nonblanks< set > },
+		{ "testee18", 64, prune_testee18< set >, cpu_has_ssse3_popcnt, count_nonblanks< set > },
+		{ "testee19", 128, prune_testee19< set >, cpu_has_ssse3_popcnt, count_nonblanks< set > },
+		{ "testee20", 64, prune_testee20< set >, cpu_has_ssse3_popcnt, count_nonblanks< set > },
+#if __x86_64__
+		{ "testee07", 32, prune_testee07< set >, cpu_has_avx2_popcnt, count_nonblanks< set > },
+		{ "testee09", 64, prune_testee09< set >, cpu_has_avx2_popcnt, count_nonblanks< set > },
+		{ "testee21", 64, prune_testee21< set >, cpu_has_avx2_popcnt, count_nonblanks< set > },
+#endif
+#endif
+	};
+
+	count = sizeof(pruners) / sizeof(pruners[0]);
+	return pruners;
+}
+
+// look up a pruner by name; null if not built in or not supported by the cpu
+template < blank_set const& set = blank_space >
+inline pruner const* find_pruner(char const* const name) {
+	size_t count;
+	pruner const* const pruners = get_pruners< set >(count);
+
+	for (size_t i = 0; i < count; ++i)
+		if (0 == strcmp(pruners[i].name, name))
+			return pruners[i].supported() ? pruners + i : 0;
+
+	return 0;
+}
+
+// per-uarch pruner preferences, most preferred first; the first pruner found supported wins, with testee00 as a
+// last resort; the picks follow the measurements in README.md; "interleaved" stands for interleaved_name()'s pick
+struct pruner_pref {
+	uint32_t part; // as returned by cpu_part()
+	uint32_t mask;
+	char const* order[4];
+};
+
+inline char const* const* get_pruner_order() {
+#if __aarch64__
+	static pruner_pref const prefs[] = {
+		{ 0x41 << 12 | 0xd08, 0xfffff, { "interleaved", "testee00" } }, // cortex-a72: outstanding permute latencies
+		{ 0x41 << 12 | 0xd07, 0xfffff, { "interleaved", "testee00" } }, // cortex-a57: ditto
+		{ 0x41 << 12 | 0xd03, 0xfffff, { "testee07", "testee06" } },    // cortex-a53
+		{ 0x61 << 12,         0xff000, { "testee07", "testee06" } },    // apple
+	};
+	static char const* const fallback[] = { "testee10", "testee07", 0 };
+	uint32_t const part = cpu_part();
+
+#elif __x86_64__ || __i386__
+	static pruner_pref const prefs[] = {
+		{ 2 << 16 | 0x14 << 8, 0xfff00, { "testee00" } }, // bobcat: death by popcnt
+	};
+	static char const* const fallback[] = { "testee07", "testee04", 0 };
+	uint32_t const part = cpu_part();
+
+#else
+	static pruner_pref const prefs[] = {
+		{ 0, 0, { 0 } }, // no preferences
+	};
+	static char const* const fallback[] = { 0 };
+	uint32_t const part = 0;
+
+#endif
+	for (size_t i = 0; i < sizeof(prefs) / sizeof(prefs[0]); ++i)
+		if (prefs[i].part == (part & prefs[i].mask))
+			return prefs[i].order;
+
+	return fallback;
+}
+
+// the interleaved pruner that takes as many batches at a time as suit the cpu, by interleave_ways(); none for a single
+// one, as a core that needs no interleaving is better served by the pruners picked for it by name; the probe runs only
+// when a preference reaches this
+inline char const* interleaved_name() {
+	size_t const ways = interleave_ways();
+	return 1 == ways ? 0 : 2 == ways ? "testee17" : 4 == ways ? "testee18" : "testee19";
+}
+
+// pick the best pruner for the cpu we run on
+template < blank_set const& set = blank_space >
+inline pruner const* select_pruner() {
+	for (char const* const* order = get_pruner_order(); *order; ++order) {
+		char const* const name = 0 == strcmp(*order, "interleaved") ? interleaved_name() : *order;
+
+		if (0 == name)
+			continue;
+
+		if (pruner const* const p = find_pruner< set >(name))
+			return p;
+	}
+
+	return find_pruner< set >("testee00");
+}
+
+// prune blanks from an arbitrary-length buffer using the best pruner for the cpu; returns the count of non-blanks in out
+template < blank_set const& set = blank_space >
+inline size_t prune(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out) {
+
+	static prune_fn const fn = select_pruner< set >()->prune;
+#if PRUNE_STATS
+	prune_stats_record& st = prune_stats_self();
+	bool const sample = prune_stats_begin(st, len);
+	size_t const kept = fn(in, len, out, len);
+	prune_stats_end(st, len, kept, sample);
+	return kept;
+
+#else
+	return fn(in, len, out, len);
+
+#endif
+}
+
+// prune blanks from an arbitrary-length buffer in place; returns the count of non-blanks left at the start of buf, the
+// rest of which is clobbered
+template < blank_set const& set = blank_space >
+inline size_t prune_inplace(
+	uint8_t* const buf,
+	size_t const len) {
+
+	return prune< set >(buf, len, buf);
+}
+
+#endif // PRUNE_H_
@@ -0,0 +1,257 @@
+// pruning of blanks from an ascii stream -- density-adaptive pruning, switching pruners by the blank statistics met
+#ifndef PRUNE_ADAPT_H_
+#define PRUNE_ADAPT_H_
+
+#include "prune.h"
+#include "corpus.h"
+#include "perfcnt.h"
+
+// Which pruner is fastest depends on the core -- testee00 beats the networks on cortex-a72 -- and on the input: the
+// skimming pruners win on long stretches of a single class and lose a few percent on mixed text. An adaptive pruner
+// keeps three candidates, testee00, the network pruner select_pruner() picks, and the skimming pruner on top of it,
+// and prunes chunk by chunk with the one that calibrated fastest for the blank density and run length seen lately.
+// Density comes for free from the kept count of each chunk; run length from a scalar scan of a sample of each. Both
+// are moving averages over about adapt_window chunks, so a stray chunk does not flip the pick -- but for a sample all
+// of one class, which is picked for as is: the skimming pruners gain most on exactly such stretches, and the averages
+// would take chunks to follow the shift into one.
+//
+// Calibration times each candidate once per process and blank set, on synthetic text over a ladder of densities and
+// two run lengths, and takes about 2ms. Each stream of chunks counts the chunks it prunes with each candidate, and its
+// switches, for auditing the picks.
+//
+// utf-8 sets are not supported: chunks are pruned by separate bulk calls, and canonicalization cannot look across.
+
+enum {
+	adapt_chunk = 4096,      // chars per pick
+	adapt_sample = 64,       // chars of a chunk scanned for runs, at most 64
+	adapt_window = 4,        // chunks of the moving averages
+	adapt_calib = 8192,      // chars of a calibration buffer
+	adapt_levels = 10,
+	adapt_runs = 2
+};
+
+enum adapt_kind {
+	adapt_scalar,
+	adapt_network,
+	adapt_skim,
+	adapt_kinds
+};
+
+// calibrated densities, and mean blank runs: short runs, as in prose and csv, and long ones, as in indented source
+static double const adapt_level[adapt_levels] = { 0.0, 0.002, 0.01, 0.05, 0.2, 0.5, 0.8, 0.95, 0.99, 1.0 };
+static double const adapt_run[adapt_runs] = { 1.0, 16.0 };
+
+// per-host calibration: the candidates, and the fastest of them for each run length and density
+struct adapt_table {
+	pruner const* cand[adapt_kinds]; // null for a kind not supported by the cpu
+	uint8_t best[adapt_runs][adapt_levels];
+};
+
+// state of an adaptive stream of chunks
+struct prune_adapt {
+	adapt_table const* table;
+	double density;               // moving average of the blank ratio; negative before the first chunk
+	double run;                   // moving average of the mean blank run
+	adapt_kind kind;              // candidate of the last chunk
+	uint64_t chunks[adapt_kinds]; // chunks pruned by each candidate
+	uint64_t switches;            // changes of candidate from chunk to chunk
+};
+
+// best of some timings of a pruner over a buffer, in ns
+inline uint64_t adapt_time(
+	pruner const* const pr,
+	uint8_t const* const in,
+	uint8_t* const out) {
+
+	uint64_t best = uint64_t(-1);
+	for (size_t i = 0; i < 3; ++i) {
+		uint64_t const start = perfcnt_ns();
+		pr->prune(in, adapt_calib, out, adapt_calib);
+		uint64_t const t = perfcnt_ns() - start;
+
+		if (t < best)
+			best = t;
+	}
+	return best;
+}
+
+template < blank_set const& set = blank_space >
+inline adapt_table adapt_calibrate() {
+	adapt_table table;
+	pruner const* const net = select_pruner< set >();
+
+	// a cpu whose pick is testee00 may still run the networks; they just lose in bulk
+	table.cand[adapt_scalar] = find_pruner< set >("testee00");
+	table.cand[adapt_network] = 0 == strcmp(net->name, "testee00") ? find_pruner< set >("testee04") : net;
+	table.cand[adapt_skim] = find_pruner< set >(32 == net->batch ? "testee21" : "testee20");
+
+	if (0 == table.cand[adapt_skim])
+		table.cand[adapt_skim] = find_pruner< set >("testee20");
+
+	uint8_t* const in = reinterpret_cast< uint8_t* >(aligned_alloc(64, 2 * adapt_calib));
+
+	// no buffer to time on: the network pruner is the pick for everything, as select_pruner() would have it
+	if (0 == in) {
+		for (size_t r = 0; r < adapt_runs; ++r)
+			for (size_t d = 0; d < adapt_levels; ++d)
+				table.best[r][d] = adapt_network;
+
+		return table;
+	}
+
+	uint8_t* const out = in + adapt_calib;
+
+	for (size_t r = 0; r < adapt_runs; ++r)
+		for (size_t d = 0; d < adapt_levels; ++d) {
+			corpus_density(in, adapt_calib, adapt_level[d], adapt_run[r]);
+
+			uint64_t best = uint64_t(-1);
+			table.best[r][d] = adapt_scalar;
+
+			for (size_t k = 0; k < adapt_kinds; ++k) {
+				if (0 == table.cand[k])
+					continue;
+
+				uint64_t const t = adapt_time(table.cand[k], in, out);
+				if (t < best) {
+					best = t;
+					table.best[r][d] = uint8_t(k);
+				}
+			}
+		}
+
+	free(in);
+	return table;
+}
+
+// the calibration of the given blank set, run on first use
+template < blank_set const& set = blank_space >
+inline adapt_table const& adapt_get_table() {
+	static adapt_table const table = adapt_calibrate< set >();
+	return table;
+}
+
+// the fastest candidate for the given density and mean blank run: the calibrated density nearest, and the run length
+// nearest by ratio
+inline adapt_kind adapt_pick(
+	adapt_table const& table,
+	double const density,
+	double const run) {
+
+	size_t d = 0;
+	while (d + 1 < adapt_levels && density > 0.5 * (adapt_level[d] + adapt_level[d + 1]))
+		++d;
+
+	size_t const r = run * run > adapt_run[0] * adapt_run[1] ? 1 : 0;
+	return adapt_kind(table.best[r][d]);
+}
+
+// bitmask of the blanks of a sample of up to 64 chars; a full sample goes by vector compares where the set is
+// classified by one, as a scan char by char takes a tenth of the time of pruning the chunk after it
+template < blank_set const& set >
+inline uint64_t adapt_bits(
+	uint8_t const* const in,
+	size_t const len) {
+
+	uint64_t mask = 0;
+
+#if __aarch64__
+	if (64 == len) {
+		for (size_t i = 0; i < 64; i += 16) {
+			uint32_t lo, hi;
+			blank_bits(blank_mask< set >(vld1q_u8(in + i)), lo, hi);
+			mask |= uint64_t(lo | hi << 8) << i;
+		}
+		return mask;
+	}
+
+#elif __x86_64__ || __i386__
+	if (64 == len && set.cmp != blank_cmp_lookup) {
+		for (size_t i = 0; i < 64; i += 16) {
+			__m128i const vin = _mm_loadu_si128(reinterpret_cast< __m128i const* >(in + i));
+			mask |= uint64_t(uint32_t(_mm_movemask_epi8(blank_mask_sse2< set >(vin)))) << i;
+		}
+		return mask;
+	}
+
+#endif
+	for (size_t i = 0; i < len; ++i)
+		mask |= uint64_t(is_blank< set >(in[i])) << i;
+
+	return mask;
+}
+
+// blanks in a sample of up to 64 chars, and the count of their runs
+template < blank_set const& set >
+inline void adapt_scan(
+	uint8_t const* const in,
+	size_t const len,
+	size_t& blanks,
+	size_t& runs) {
+
+	uint64_t const mask = adapt_bits< set >(in, len);
+
+	blanks = __builtin_popcountll(mask);
+	runs = __builtin_popcountll(mask & ~(mask << 1));
+}
+
+// start an adaptive stream; calibrates the blank set on first use
+template < blank_set const& set = blank_space >
+inline void prune_adapt_init(prune_adapt& st) {
+	static_assert(!set.utf8, "utf-8 sets not supported by adaptive pruning");
+
+	st.table = &adapt_get_table< set >();
+	st.density = -1.0;
+	st.run = adapt_run[0];
+	st.kind = adapt_network;
+	st.switches = 0;
+
+	for (size_t k = 0; k < adapt_kinds; ++k)
+		st.chunks[k] = 0;
+}
+
+// prune blanks from len chars of in, chunk by chunk, each with the candidate picked for the statistics so far; returns
+// the count of non-blanks in out, which may be in, as with prune(). Statistics carry over from call to call
+template < blank_set const& set = blank_space >
+inline size_t prune_adapt_run(
+	prune_adapt& st,
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out) {
+
+	double const rate = 1.0 / adapt_window;
+	size_t pos = 0;
+
+	for (size_t i = 0; i < len; i += adapt_chunk) {
+		size_t const n = len - i < size_t(adapt_chunk) ? len - i : size_t(adapt_chunk);
+
+		size_t const sample = n < size_t(adapt_sample) ? n : size_t(adapt_sample);
+		size_t blanks, runs;
+		adapt_scan< set >(in + i, sample, blanks, runs);
+
+		// the sample alone seeds the density; after, the kept counts of whole chunks drive it
+		if (st.density < 0.0)
+			st.density = double(blanks) / double(sample);
+
+		// a sample with no blanks tells nothing of runs
+		if (runs)
+			st.run += (double(blanks) / double(runs) - st.run) * rate;
+
+		// a sample of a single class marks a shift the averages would take chunks to follow
+		double const density = 0 == blanks || sample == blanks ? double(blanks) / double(sample) : st.density;
+
+		adapt_kind const kind = adapt_pick(*st.table, density, st.run);
+		st.switches += kind != st.kind;
+		st.kind = kind;
+		st.chunks[kind] += 1;
+
+		// the output of a chunk never passes the input of the next, so in-place goes chunk by chunk
+		size_t const kept = st.table->cand[kind]->prune(in + i, n, out + pos, len - pos);
+
+		st.density += (double(n - kept) / double(n) - st.density) * rate;
+		pos += kept;
+	}
+	return pos;
+}
+
+#endif // PRUNE_ADAPT_H_
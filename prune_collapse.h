@@ -0,0 +1,268 @@
+// pruning of blanks from an ascii stream -- collapsing of blank runs
+#ifndef PRUNE_COLLAPSE_H_
+#define PRUNE_COLLAPSE_H_
+
+#include "prune.h"
+
+// Rather than pruning all blanks, collapse each run of blanks into a single space, e.g. "a  \t b" -> "a b", optionally
+// trimming the runs at either end. That is pruning by testee04 of every blank that follows a blank, and replacing the
+// blanks left, each the head of a run, by ' '; the one blank lane that cannot see its predecessor, the first, gets its
+// state from the last lane of the previous batch, so runs straddling batches, or calls of collapse_feed, collapse as a
+// whole.
+
+// collapse state, threaded across batches and calls
+struct collapse_state {
+	uint8_t blank; // all ones if the last char seen was a blank, or if leading blanks get trimmed and no char was seen
+};
+
+enum {
+	collapse_trim_head = 1, // drop a leading run of blanks
+	collapse_trim_tail = 2  // drop a trailing run of blanks
+};
+
+inline collapse_state collapse_init(bool const trim_head) {
+	collapse_state const st = { uint8_t(trim_head ? 0xff : 0) };
+	return st;
+}
+
+// scalar collapser of an arbitrary-length buffer; also the tail of the vector ones
+template < blank_set const& set = blank_space >
+inline size_t collapse_chars(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	collapse_state& st) {
+
+	size_t pos = 0;
+	for (size_t i = 0; i < len; ++i) {
+		uint8_t const c = in[i];
+
+		if (!is_blank< set >(c)) {
+			out[pos++] = c;
+			st.blank = 0;
+		}
+		else if (0 == st.blank) {
+			out[pos++] = ' ';
+			st.blank = 0xff;
+		}
+	}
+	return pos;
+}
+
+#if __aarch64__
+// the vector collapsers carry the blank mask of the previous batch, of which only the last lane counts, rather than
+// the state proper, keeping the movement between the two off the loop-carried path
+typedef uint8x16_t collapse_carry;
+
+inline collapse_carry collapse_carry_of(collapse_state const st) {
+	return vdupq_n_u8(st.blank);
+}
+
+inline collapse_state collapse_state_of(collapse_carry const carry) {
+	collapse_state const st = { vgetq_lane_u8(carry, 15) };
+	return st;
+}
+
+// collapser, 16-batch; testee04 over the blanks that follow a blank, the last lane of carry standing for the lane
+// before the first
+template < blank_set const& set = blank_space >
+inline size_t collapse04(
+	uint8_t const* const input,
+	uint8_t* const output,
+	collapse_carry& carry) {
+
+	uint8x16_t const vin = vld1q_u8(input);
+	uint8x16_t const bmask = blank_mask< set >(vin);
+
+	// blanks whose predecessor is a blank go; the heads of runs stay, as spaces
+	uint8x16_t const drop = vandq_u8(bmask, vextq_u8(carry, bmask, 15));
+	uint8x16_t const vsp = vbslq_u8(bmask, vdupq_n_u8(' '), vin);
+
+	uint8x16_t const risen = vorrq_u8(drop, (uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 });
+	uint8x16_t const index = sort_index04(risen);
+
+	uint8x16_t const res = vqtbl1q_u8(vsp, index);
+	vst1q_u8(output, res);
+
+	carry = bmask;
+	return sizeof(uint8x16_t) + int8_t(vaddvq_u8(drop));
+}
+
+#elif __x86_64__ || __i386__
+// the vector collapsers carry the blank mask of the previous batch, of which only the last lane counts, rather than
+// the state proper, keeping the movement between the two off the loop-carried path
+typedef __m128i collapse_carry;
+
+inline collapse_carry collapse_carry_of(collapse_state const st) {
+	return _mm_set1_epi8(st.blank);
+}
+
+inline collapse_state collapse_state_of(collapse_carry const carry) {
+	collapse_state const st = { uint8_t(-(_mm_movemask_epi8(carry) >> 15 & 1)) };
+	return st;
+}
+
+// collapser, 16-batch; testee04 over the blanks that follow a blank, the last lane of carry standing for the lane
+// before the first
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t collapse04(
+	uint8_t const* const input,
+	uint8_t* const output,
+	collapse_carry& carry) {
+
+	__m128i const vin = _mm_loadu_si128(reinterpret_cast< __m128i const* >(input));
+	__m128i const bmask = blank_mask< set >(vin);
+
+	// blanks whose predecessor is a blank go; the heads of runs stay, as spaces
+	__m128i const drop = _mm_and_si128(bmask, _mm_alignr_epi8(bmask, carry, 15));
+	__m128i const vsp = _mm_or_si128(_mm_andnot_si128(bmask, vin), _mm_and_si128(bmask, _mm_set1_epi8(' ')));
+
+	__m128i const risen = _mm_or_si128(drop, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+	__m128i const index = sort_index04(risen);
+
+	uint32_t const bitmask = ~_mm_movemask_epi8(drop);
+	store_pieces04(_mm_shuffle_epi8(vsp, index), pieces_of04(bitmask), output);
+
+	carry = bmask;
+	return _mm_popcnt_u32(bitmask & 0xffff);
+}
+
+#else
+typedef uint8_t collapse_carry; // no vector collapsers
+
+#endif
+// bulk collapsing of an arbitrary-length buffer by the given collapser; returns the count of chars in out, which
+// needs no more room than len; out may equal in, for the reasons given at prune_bulk, and the tail goes to the scalar
+// collapser; utf-8 sets canonicalize each batch first, and leave a trailing partial sequence alone, so feed those
+// whole sequences
+template < size_t batch, size_t (&collapser)(uint8_t const*, uint8_t*, collapse_carry&), blank_set const& set >
+__attribute__ ((always_inline)) inline size_t collapse_bulk(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	collapse_state& st) {
+
+	size_t i = 0, pos = 0;
+	collapse_carry carry = collapse_carry_of(st);
+
+	if (set.utf8) {
+		utf8_state ust = utf8_init();
+		uint8_t tmp[batch] __attribute__ ((aligned(64)));
+
+		for (; i < len; i += batch) {
+			size_t const n = len - i < batch ? len - i : batch;
+			utf8_canon< batch, set >(in + i, n, len - i, tmp, ust);
+
+			if (n < batch) {
+				st = collapse_state_of(carry);
+				return pos + collapse_chars< set >(tmp, n, out + pos, st);
+			}
+			pos += collapser(tmp, out + pos, carry);
+		}
+		st = collapse_state_of(carry);
+		return pos;
+	}
+
+	for (; i + batch <= len; i += batch)
+		pos += collapser(in + i, out + pos, carry);
+
+	st = collapse_state_of(carry);
+	return pos + collapse_chars< set >(in + i, len - i, out + pos, st);
+}
+
+// bulk collapser entry points; these carry the isa of their collapser so the latter inlines
+typedef size_t (*collapse_fn)(uint8_t const* in, size_t len, uint8_t* out, collapse_state& st);
+
+template < blank_set const& set = blank_space >
+inline size_t collapse_testee00(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	collapse_state& st) {
+
+	if (set.utf8) {
+		utf8_state ust = utf8_init();
+		uint8_t tmp[64] __attribute__ ((aligned(64)));
+		size_t pos = 0;
+
+		for (size_t i = 0; i < len; i += sizeof(tmp)) {
+			size_t const n = len - i < sizeof(tmp) ? len - i : sizeof(tmp);
+			utf8_canon< sizeof(tmp), set >(in + i, n, len - i, tmp, ust);
+			pos += collapse_chars< set >(tmp, n, out + pos, st);
+		}
+		return pos;
+	}
+
+	return collapse_chars< set >(in, len, out, st);
+}
+
+#if __aarch64__
+template < blank_set const& set = blank_space >
+inline size_t collapse_testee04(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	collapse_state& st) {
+
+	return collapse_bulk< 16, collapse04< set >, set >(in, len, out, st);
+}
+
+#elif __x86_64__ || __i386__
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t collapse_testee04(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	collapse_state& st) {
+
+	return collapse_bulk< 16, collapse04< set >, set >(in, len, out, st);
+}
+
+#endif
+// pick the best collapser for the cpu we run on
+template < blank_set const& set = blank_space >
+inline collapse_fn select_collapser() {
+#if __aarch64__
+	return collapse_testee04< set >;
+
+#elif __x86_64__ || __i386__
+	return cpu_has_ssse3_popcnt() ? collapse_testee04< set > : collapse_testee00< set >;
+
+#else
+	return collapse_testee00< set >;
+
+#endif
+}
+
+// collapse the blank runs of the next piece of a stream, by the best collapser for the cpu; returns the count of chars
+// in out, which needs no more room than len; out may equal in. A run straddling pieces yields a single space, in the
+// output of the piece it starts in, so the tail of the stream is not trimmed; to trim it, drop the last char of the
+// stream's output if st.blank is still set at the end of the stream and the output is not empty
+template < blank_set const& set = blank_space >
+inline size_t collapse_feed(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	collapse_state& st) {
+
+	static collapse_fn const fn = select_collapser< set >();
+	return fn(in, len, out, st);
+}
+
+// collapse the blank runs of an arbitrary-length buffer, trimming either end by the collapse_trim_* flags; returns the
+// count of chars in out, which needs no more room than len; out may equal in
+template < blank_set const& set = blank_space >
+inline size_t collapse(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	unsigned const flags = 0) {
+
+	collapse_state st = collapse_init(0 != (flags & collapse_trim_head));
+	size_t const pos = collapse_feed< set >(in, len, out, st);
+
+	// a trailing run left a space, unless it was all there is and trimmed as a leading one
+	return flags & collapse_trim_tail && st.blank && pos ? pos - 1 : pos;
+}
+
+#endif // PRUNE_COLLAPSE_H_
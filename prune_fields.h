@@ -0,0 +1,243 @@
+// pruning of blanks from an ascii stream -- pruning of many short fields, each on its own
+#ifndef PRUNE_FIELDS_H_
+#define PRUNE_FIELDS_H_
+
+#include "prune.h"
+
+// Short fields -- csv cells, key/value tokens of 8 - 40 chars -- pruned one call each waste most of every batch on
+// the field's edges and most of the time on the call. Given as one arena of the fields back to back, and the offsets
+// of their bounds in it, they prune as one buffer: every batch takes in as many fields, or pieces of fields, as it
+// spans, and the bound of each field in the output is found from the non-blank bitmask of the batch it falls in, by
+// the count of non-blanks below its lane -- the way testee04 places its 4-lane pieces by len0 - len2.
+
+// scalar field pruner, 16-batch; sets bit i of bits for a non-blank at lane i
+template < blank_set const& set = blank_space >
+inline size_t field00(
+	uint8_t const* const input,
+	uint8_t* const output,
+	uint32_t& bits) {
+
+	size_t pos = 0;
+	bits = 0;
+	for (size_t i = 0; i < 16; ++i) {
+		uint8_t const c = input[i];
+		output[pos] = c;
+		uint32_t const keep = is_blank< set >(c) ? 0 : 1;
+		bits |= keep << i;
+		pos += keep;
+	}
+	return pos;
+}
+
+#if __aarch64__
+// field pruner, 16-batch; testee04 plus its non-blank bitmask
+template < blank_set const& set = blank_space >
+inline size_t field04(
+	uint8_t const* const input,
+	uint8_t* const output,
+	uint32_t& bits) {
+
+	uint8x16_t const vin = vld1q_u8(input);
+	uint8x16_t const bmask = blank_mask< set >(vin);
+
+	uint8x16_t const risen = vorrq_u8(bmask, (uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 });
+	uint8x16_t const index = sort_index04(risen);
+
+	vst1q_u8(output, vqtbl1q_u8(vin, index));
+
+	uint32_t lo, hi;
+	blank_bits(bmask, lo, hi);
+	bits = ~(hi << 8 | lo) & 0xffff;
+	return sizeof(uint8x16_t) + int8_t(vaddvq_u8(bmask));
+}
+
+#elif __x86_64__ || __i386__
+// field pruner, 16-batch; testee04 plus its non-blank bitmask
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t field04(
+	uint8_t const* const input,
+	uint8_t* const output,
+	uint32_t& bits) {
+
+	__m128i const vin = _mm_loadu_si128(reinterpret_cast< __m128i const* >(input));
+	__m128i const bmask = blank_mask< set >(vin);
+
+	__m128i const risen = _mm_or_si128(bmask, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+	__m128i const index = sort_index04(risen);
+
+	uint32_t const bitmask = ~_mm_movemask_epi8(bmask) & 0xffff;
+	store_pieces04(_mm_shuffle_epi8(vin, index), pieces_of04(bitmask), output);
+
+	bits = bitmask;
+	return _mm_popcnt_u32(bitmask);
+}
+
+#endif
+// batches per span whose bounds are placed at once
+enum {
+	prune_fields_span = 64
+};
+
+// place the output bounds of the fields whose input bounds fall in a span of n batches from input offset start, by
+// the output position and the non-blank bitmask of each batch, and the output position past the span; f is the next
+// bound to place, advanced past those placed. The bounds go in a loop of their own, with no branch on how many fall
+// in a batch -- one, two or none, and as random as the field lengths
+inline void place_bounds(
+	uint32_t const* const off,
+	size_t const count,
+	uint32_t* const out_off,
+	size_t& f,
+	size_t const start,
+	size_t const n,
+	uint32_t (&at)[prune_fields_span + 1],
+	uint16_t (&bits)[prune_fields_span + 1],
+	size_t const pos) {
+
+	at[n] = uint32_t(pos);
+	bits[n] = 0;
+
+	for (; f <= count && off[f] - off[0] <= start + n * 16; ++f) {
+		uint32_t const rel = uint32_t(off[f] - off[0] - start);
+		uint32_t const lane = rel & 15;
+		out_off[f] = at[rel >> 4] + __builtin_popcount(bits[rel >> 4] & ((uint32_t(1) << lane) - 1));
+	}
+}
+
+// bulk pruning of count fields by the given field pruner: field k is arena[off[k], off[k + 1]); its pruned chars go to
+// out[out_off[k], out_off[k + 1]), out_off[0] being 0; returns out_off[count], the count of non-blanks in out, which
+// needs no more room than the fields. Offsets are 32-bit, so the fields must span below 4GB; as with prune_bulk,
+// batches that could store past that span go off-line, and utf-8 sets are canonicalized first, which keeps the bounds,
+// as a unicode space canonicalizes in place
+template < size_t (&fielder)(uint8_t const*, uint8_t*, uint32_t&), blank_set const& set >
+__attribute__ ((always_inline)) inline size_t prune_fields_bulk(
+	uint8_t const* const arena,
+	uint32_t const* const off,
+	size_t const count,
+	uint8_t* const out,
+	uint32_t* const out_off) {
+
+	size_t const batch = 16;
+	uint8_t tmp_in[batch] __attribute__ ((aligned(64)));
+	uint8_t tmp_out[batch] __attribute__ ((aligned(64)));
+
+	// output position and non-blank bitmask of each batch of the span in flight
+	uint32_t at[prune_fields_span + 1];
+	uint16_t bits[prune_fields_span + 1];
+	size_t start = 0, n = 0, f = 0;
+
+	uint8_t const* const in = arena + off[0];
+	size_t const len = off[count] - off[0];
+	utf8_state st = utf8_init();
+
+	for (size_t i = 0, pos = 0; ; i += batch) {
+		if (prune_fields_span == n || i >= len) {
+			place_bounds(off, count, out_off, f, start, n, at, bits, pos);
+			start = i;
+			n = 0;
+
+			if (i >= len)
+				return pos;
+		}
+
+		size_t const left = len - i < batch ? len - i : batch;
+		uint8_t const* src = in + i;
+
+		// the tail goes padded with blanks, as at prune_bulk
+		if (set.utf8) {
+			utf8_canon< batch, set >(in + i, left, len - i, tmp_in, st);
+			src = tmp_in;
+		}
+		else if (left < batch) {
+			memset(tmp_in, set.pad, sizeof(tmp_in));
+			memcpy(tmp_in, in + i, left);
+			src = tmp_in;
+		}
+
+		bool const direct = pos + batch <= len;
+		uint32_t b;
+		size_t const kept = fielder(src, direct ? out + pos : tmp_out, b) - (set.empty ? batch - left : 0);
+
+		if (!direct)
+			memcpy(out + pos, tmp_out, kept);
+
+		at[n] = uint32_t(pos);
+		bits[n++] = uint16_t(b);
+		pos += kept;
+	}
+}
+
+// bulk entry points; these carry the isa of their pruner so the latter inlines
+typedef size_t (*prune_fields_fn)(
+	uint8_t const* arena,
+	uint32_t const* off,
+	size_t count,
+	uint8_t* out,
+	uint32_t* out_off);
+
+template < blank_set const& set = blank_space >
+inline size_t prune_fields00(
+	uint8_t const* const arena,
+	uint32_t const* const off,
+	size_t const count,
+	uint8_t* const out,
+	uint32_t* const out_off) {
+
+	return prune_fields_bulk< field00< set >, set >(arena, off, count, out, out_off);
+}
+
+#if __aarch64__
+template < blank_set const& set = blank_space >
+inline size_t prune_fields04(
+	uint8_t const* const arena,
+	uint32_t const* const off,
+	size_t const count,
+	uint8_t* const out,
+	uint32_t* const out_off) {
+
+	return prune_fields_bulk< field04< set >, set >(arena, off, count, out, out_off);
+}
+
+#elif __x86_64__ || __i386__
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t prune_fields04(
+	uint8_t const* const arena,
+	uint32_t const* const off,
+	size_t const count,
+	uint8_t* const out,
+	uint32_t* const out_off) {
+
+	return prune_fields_bulk< field04< set >, set >(arena, off, count, out, out_off);
+}
+
+#endif
+// pick the best field pruner for the cpu we run on
+template < blank_set const& set = blank_space >
+inline prune_fields_fn select_fields_pruner() {
+#if __aarch64__
+	return prune_fields04< set >;
+
+#elif __x86_64__ || __i386__
+	return cpu_has_ssse3_popcnt() ? prune_fields04< set > : prune_fields00< set >;
+
+#else
+	return prune_fields00< set >;
+
+#endif
+}
+
+// prune blanks from each of count fields of an arena below 4GB, field k being arena[off[k], off[k + 1]); writes the
+// pruned fields back to back to out, with their bounds to out_off, count + 1 of them, from 0; returns the count of
+// non-blanks in out
+template < blank_set const& set = blank_space >
+inline size_t prune_fields(
+	uint8_t const* const arena,
+	uint32_t const* const off,
+	size_t const count,
+	uint8_t* const out,
+	uint32_t* const out_off) {
+
+	static prune_fields_fn const fn = select_fields_pruner< set >();
+	return fn(arena, off, count, out, out_off);
+}
+
+#endif // PRUNE_FIELDS_H_
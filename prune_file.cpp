@@ -0,0 +1,324 @@
+// pruning of blanks from an ascii stream -- command-line tool over files
+//
+// build: g++ -O3 prune_file.cpp -o prune -pthread
+// usage: prune [-t threads] [-p pruner] [-s space|ascii|unicode|keep-lf|comma] [-o outfile] [infile]
+//
+// The input file is mmapped and pruned straight out of the page cache, never copied into a staging buffer; without an
+// input file stdin is read instead, and an input that is not a regular file, e.g. a pipe, is read in large blocks. With
+// -o the output goes to a file of the input's size, mmapped and pruned into, then truncated to the count of non-blanks;
+// otherwise the output is written to stdout in large blocks; a non-mappable input is pruned in place, block by block.
+// Blocks never split a utf-8 sequence. -t prunes across the given count of threads, by prune_lookback, and -p forces a
+// pruner over the runtime pick. -s picks the chars to prune: all up to ' ' by default, which on amd64 includes all
+// chars above 0x7f; all up to ' ' but nothing above 0x7f, so utf-8 passes intact; those and the unicode spaces; all up
+// to ' ' but '\n', to keep records apart; or those plus ',' and '\x7f'.
+#include "prune.h"
+#include "prune_mt.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+enum {
+	block_size = 1 << 24 // input chars per write to stdout, or per read from a non-mappable input
+};
+
+static constexpr blank_set blank_keep_lf = blank_set_minus(blank_ascii, blank_set_of("\n"));
+static constexpr blank_set blank_comma = blank_set_union(blank_ascii, blank_set_of(",\x7f"));
+
+struct named_set {
+	char const* name;
+	pruner const* (*select)();
+	pruner const* (*find)(char const*);
+};
+
+static named_set const sets[] = {
+	{ "space",   select_pruner< blank_space >,   find_pruner< blank_space > },
+	{ "ascii",   select_pruner< blank_ascii >,   find_pruner< blank_ascii > },
+	{ "unicode", select_pruner< blank_unicode >, find_pruner< blank_unicode > },
+	{ "keep-lf", select_pruner< blank_keep_lf >, find_pruner< blank_keep_lf > },
+	{ "comma",   select_pruner< blank_comma >,   find_pruner< blank_comma > },
+};
+
+struct prune_conf {
+	pruner const* pr;
+	size_t threads;
+};
+
+static size_t prune_block(
+	prune_conf const& conf,
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out) {
+
+	return prune_lookback(in, len, out, conf.threads, conf.pr);
+}
+
+// write all of buf, retrying short writes; false on error
+static bool write_all(
+	int const fd,
+	uint8_t const* buf,
+	size_t len) {
+
+	while (len) {
+		ssize_t const n = write(fd, buf, len);
+		if (n < 0) {
+			if (EINTR == errno)
+				continue;
+			return false;
+		}
+		buf += n;
+		len -= size_t(n);
+	}
+
+	return true;
+}
+
+// fill buf from fd up to len, retrying short reads; returns the count read, short only at eof, or -1 on error
+static ssize_t read_all(
+	int const fd,
+	uint8_t* const buf,
+	size_t const len) {
+
+	size_t pos = 0;
+	while (pos < len) {
+		ssize_t const n = read(fd, buf + pos, len - pos);
+		if (n < 0) {
+			if (EINTR == errno)
+				continue;
+			return -1;
+		}
+		if (0 == n)
+			break;
+		pos += size_t(n);
+	}
+
+	return ssize_t(pos);
+}
+
+// map a regular file for reading, in full and sequentially; null on error or an empty file
+static uint8_t const* map_input(
+	int const fd,
+	size_t const len) {
+
+	if (0 == len)
+		return 0;
+
+	int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+	flags |= MAP_POPULATE;
+
+#endif
+	void* const p = mmap(0, len, PROT_READ, flags, fd, 0);
+	if (MAP_FAILED == p)
+		return 0;
+
+	madvise(p, len, MADV_SEQUENTIAL);
+	return reinterpret_cast< uint8_t const* >(p);
+}
+
+// prune the mapped input into a mapped output file of the input's size, then cut that to size
+static bool prune_to_file(
+	prune_conf const& conf,
+	uint8_t const* const in,
+	size_t const len,
+	char const* const name) {
+
+	int const fd = open(name, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (-1 == fd) {
+		fprintf(stderr, "error: cannot open %s: %s\n", name, strerror(errno));
+		return false;
+	}
+
+	bool ok = true;
+	size_t kept = 0;
+
+	if (len) {
+		void* out = MAP_FAILED;
+		if (0 == ftruncate(fd, off_t(len)))
+			out = mmap(0, len, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+
+		if (MAP_FAILED == out) {
+			fprintf(stderr, "error: cannot map %s: %s\n", name, strerror(errno));
+			ok = false;
+		}
+		else {
+			madvise(out, len, MADV_SEQUENTIAL);
+			kept = prune_block(conf, in, len, reinterpret_cast< uint8_t* >(out));
+			munmap(out, len);
+		}
+	}
+
+	if (ok && 0 != ftruncate(fd, off_t(kept))) {
+		fprintf(stderr, "error: cannot truncate %s: %s\n", name, strerror(errno));
+		ok = false;
+	}
+
+	return 0 == close(fd) && ok;
+}
+
+// prune the mapped input to stdout, a block at a time
+static bool prune_to_stdout(
+	prune_conf const& conf,
+	uint8_t const* const in,
+	size_t const len) {
+
+	// a block's end moves by up to 3 chars to the next utf-8 lead
+	uint8_t* const out = reinterpret_cast< uint8_t* >(malloc(len < size_t(block_size) ? len : size_t(block_size) + 3));
+	if (0 == out && len) {
+		fprintf(stderr, "error: out of memory\n");
+		return false;
+	}
+
+	bool ok = true;
+	for (size_t pos = 0; pos < len && ok; ) {
+		size_t const end = len - pos <= size_t(block_size) ? len : prune_mt_boundary(in, len, pos + block_size);
+		ok = write_all(STDOUT_FILENO, out, prune_block(conf, in + pos, end - pos, out));
+		pos = end;
+	}
+
+	free(out);
+	if (!ok)
+		fprintf(stderr, "error: cannot write output: %s\n", strerror(errno));
+
+	return ok;
+}
+
+// prune a non-mappable input in place, a block at a time; the output may be a file or stdout
+static bool prune_stream(
+	prune_conf const& conf,
+	int const in_fd,
+	char const* const name) {
+
+	int const fd = name ? open(name, O_WRONLY | O_CREAT | O_TRUNC, 0644) : STDOUT_FILENO;
+	if (-1 == fd) {
+		fprintf(stderr, "error: cannot open %s: %s\n", name, strerror(errno));
+		return false;
+	}
+
+	uint8_t* const buf = reinterpret_cast< uint8_t* >(malloc(block_size));
+	if (0 == buf) {
+		fprintf(stderr, "error: out of memory\n");
+		if (name)
+			close(fd);
+		return false;
+	}
+
+	// the chars past the last utf-8 lead in the final 3 of a full block are carried over to the next
+	bool ok = true;
+	size_t carry = 0;
+	for (;;) {
+		ssize_t const n = read_all(in_fd, buf + carry, block_size - carry);
+		if (n < 0) {
+			fprintf(stderr, "error: cannot read input: %s\n", strerror(errno));
+			ok = false;
+			break;
+		}
+
+		size_t const len = carry + size_t(n);
+		size_t const end = len == size_t(block_size) ? prune_mt_boundary(buf, len, len - 3) : len;
+		if (0 == end)
+			break;
+
+		if (!write_all(fd, buf, prune_block(conf, buf, end, buf))) {
+			fprintf(stderr, "error: cannot write output: %s\n", strerror(errno));
+			ok = false;
+			break;
+		}
+
+		carry = len - end;
+		memmove(buf, buf + end, carry);
+	}
+
+	free(buf);
+	if (name && 0 != close(fd))
+		ok = false;
+
+	return ok;
+}
+
+int main(int argc, char** argv) {
+	char const* out_name = 0;
+	char const* pr_name = 0;
+	named_set const* set = sets;
+
+	prune_conf conf;
+	conf.threads = 1;
+
+	int opt;
+	while (-1 != (opt = getopt(argc, argv, "t:p:s:o:"))) {
+		switch (opt) {
+		case 't':
+			conf.threads = strtoul(optarg, 0, 10);
+			break;
+		case 'p':
+			pr_name = optarg;
+			break;
+		case 's':
+			for (set = sets; set < sets + sizeof(sets) / sizeof(sets[0]) && strcmp(set->name, optarg); ++set) {}
+			if (set == sets + sizeof(sets) / sizeof(sets[0])) {
+				fprintf(stderr, "error: unknown blank set %s\n", optarg);
+				return -1;
+			}
+			break;
+		case 'o':
+			out_name = optarg;
+			break;
+		default:
+			fprintf(stderr, "usage: %s [-t threads] [-p pruner] [-s space|ascii|unicode|keep-lf|comma] [-o outfile] [infile]\n", argv[0]);
+			return -1;
+		}
+	}
+
+	if (0 == conf.threads) {
+		fprintf(stderr, "error: threads must be non-zero\n");
+		return -1;
+	}
+
+	conf.pr = pr_name ? set->find(pr_name) : set->select();
+	if (0 == conf.pr) {
+		fprintf(stderr, "error: unknown or unsupported pruner %s\n", pr_name);
+		return -1;
+	}
+
+	int fd = STDIN_FILENO;
+	if (optind < argc && 0 != strcmp(argv[optind], "-")) {
+		fd = open(argv[optind], O_RDONLY);
+		if (-1 == fd) {
+			fprintf(stderr, "error: cannot open %s: %s\n", argv[optind], strerror(errno));
+			return -1;
+		}
+	}
+
+	struct stat st;
+	if (0 != fstat(fd, &st)) {
+		fprintf(stderr, "error: cannot stat input: %s\n", strerror(errno));
+		close(fd);
+		return -1;
+	}
+
+	// pipes and the like cannot be mapped
+	if (!S_ISREG(st.st_mode)) {
+		bool const ok = prune_stream(conf, fd, out_name);
+		close(fd);
+		return ok ? 0 : -1;
+	}
+
+	size_t const len = size_t(st.st_size);
+	uint8_t const* const in = map_input(fd, len);
+	if (0 == in && len) {
+		fprintf(stderr, "error: cannot map input: %s\n", strerror(errno));
+		return -1;
+	}
+
+	bool const ok = out_name ? prune_to_file(conf, in, len, out_name) : prune_to_stdout(conf, in, len);
+
+	if (in)
+		munmap(const_cast< uint8_t* >(in), len);
+	close(fd);
+
+	return ok ? 0 : -1;
+}
@@ -0,0 +1,375 @@
+// pruning of blanks from an ascii stream -- json minification, keeping the blanks of string literals
+#ifndef PRUNE_JSON_H_
+#define PRUNE_JSON_H_
+
+#include "prune.h"
+
+// Minifying json is pruning the blanks outside its strings. A minifier takes 64-char blocks, and finds their string
+// chars as bitmasks: quotes not escaped by an odd run of backslashes open or close a string, and the prefix xor of
+// those quotes -- a carry-less multiply by all ones, where there is one -- gives the chars from an opening quote on to
+// its closing quote. That mask, xored with the string state at the end of the previous block, is expanded to lanes and
+// taken off the blank mask, which then goes through sort_store04() or sort_store07() of prune.h, the sort and store of
+// testee04 and testee07, as it is; the chars of a string, blanks included, are kept as non-blanks are. The state is two
+// bits, in-string and escaped, carried from block to block and from call to call, so a document may be fed in chunks of
+// any size and split anywhere, even mid-escape.
+//
+// Escapes are tracked everywhere, as json has backslashes in strings only; on input that is not json, the output is
+// that of the scalar minifier, which follows the same rules char by char. Sets holding '"' or '\\' make no sense here,
+// and utf-8 sets are not supported, as canonicalization would need to skip strings; blank_ascii, the default, keeps
+// all chars above 0x7f, so utf-8 text passes intact.
+
+// minifier state, threaded across blocks and calls
+struct json_state {
+	uint64_t string;  // all ones if the last char seen was in a string, its opening quote included
+	uint64_t escaped; // 1 if the next char is escaped
+};
+
+inline json_state json_init() {
+	json_state const st = { 0, 0 };
+	return st;
+}
+
+// scalar minifier of an arbitrary-length buffer; also the tail of the vector ones
+template < blank_set const& set = blank_ascii >
+inline size_t json_chars(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	json_state& st) {
+
+	size_t pos = 0;
+	for (size_t i = 0; i < len; ++i) {
+		uint8_t const c = in[i];
+		bool const quote = '"' == c && 0 == st.escaped;
+
+		st.escaped = '\\' == c && 0 == st.escaped;
+		st.string ^= quote ? ~uint64_t(0) : 0;
+
+		out[pos] = c;
+		pos += st.string || quote || !is_blank< set >(c) ? 1 : 0;
+	}
+	return pos;
+}
+
+// chars escaped by the backslashes of a block, given as a bitmask, and whether the first char of the next block is;
+// a run of backslashes escapes the char after it if odd, and the runs starting on odd bits are told from those
+// starting on even ones by the carries of adding their starts to them
+__attribute__ ((always_inline)) inline uint64_t json_escapes(
+	uint64_t backslash,
+	uint64_t& escaped) {
+
+	uint64_t const even = 0x5555555555555555;
+
+	backslash &= ~escaped;
+	uint64_t const follows = backslash << 1 | escaped;
+	uint64_t const odd_starts = backslash & ~even & ~follows;
+
+	uint64_t even_ends;
+	escaped = __builtin_add_overflow(odd_starts, backslash, &even_ends);
+
+	return (even ^ even_ends << 1) & follows;
+}
+
+// prefix xor of a bitmask, by shifts; bit i is the xor of bits 0 - i
+inline uint64_t json_prefix_xor_shift(uint64_t m) {
+	m ^= m << 1;
+	m ^= m << 2;
+	m ^= m << 4;
+	m ^= m << 8;
+	m ^= m << 16;
+	m ^= m << 32;
+	return m;
+}
+
+// unescaped quotes of a block, given the bitmasks of its quotes and backslashes; the prefix xor of those, xored with
+// the string state at the start of the block, gives its string chars -- a closing quote is not one, which is of no
+// matter to pruning blanks
+__attribute__ ((always_inline)) inline uint64_t json_quotes(
+	uint64_t const quote,
+	uint64_t const backslash,
+	json_state& st) {
+
+	// json has backslashes in strings only, and few there; the escapes are skipped for the blocks with none
+	if (0 == (backslash | st.escaped))
+		return quote;
+
+	return quote & ~json_escapes(backslash, st.escaped);
+}
+
+#if __aarch64__
+// prefix xor of a bitmask, by a carry-less multiply by all ones
+#if __ARM_FEATURE_AES
+inline uint64_t json_prefix_xor(uint64_t const m) {
+	return vgetq_lane_u64(vreinterpretq_u64_p128(vmull_p64(m, ~uint64_t(0))), 0);
+}
+
+#else
+inline uint64_t json_prefix_xor(uint64_t const m) {
+	return json_prefix_xor_shift(m);
+}
+
+#endif
+// bitmask of the non-zero lanes of four vectors, lane i of vector k at bit 16 k + i
+inline uint64_t json_bits(
+	uint8x16_t const m0,
+	uint8x16_t const m1,
+	uint8x16_t const m2,
+	uint8x16_t const m3) {
+
+	uint8x16_t const bit = (uint8x16_t) { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+	uint8x16_t const s01 = vpaddq_u8(vandq_u8(m0, bit), vandq_u8(m1, bit));
+	uint8x16_t const s23 = vpaddq_u8(vandq_u8(m2, bit), vandq_u8(m3, bit));
+	uint8x16_t const s = vpaddq_u8(s01, s23);
+
+	return vgetq_lane_u64(vreinterpretq_u64_u8(vpaddq_u8(s, s)), 0);
+}
+
+// 0xff for the lanes of the set bits of a 16-bit mask
+inline uint8x16_t json_lanes(uint64_t const bits) {
+	uint8x16_t const bit = (uint8x16_t) { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+	uint8x16_t const v = vqtbl1q_u8(vreinterpretq_u8_u16(vdupq_n_u16(uint16_t(bits))),
+		(uint8x16_t) { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1 });
+
+	return vtstq_u8(v, bit);
+}
+
+// minifier, 64-batch; testee04 of each 16 chars over their blanks outside strings
+template < blank_set const& set = blank_ascii >
+inline size_t json04(
+	uint8_t const* const input,
+	uint8_t* const output,
+	json_state& st) {
+
+	// all of the block is loaded before any of it is stored, for in-place
+	uint8x16_t const vin0 = vld1q_u8(input);
+	uint8x16_t const vin1 = vld1q_u8(input + 16);
+	uint8x16_t const vin2 = vld1q_u8(input + 32);
+	uint8x16_t const vin3 = vld1q_u8(input + 48);
+
+	uint8x16_t const vq = vdupq_n_u8('"');
+	uint8x16_t const vb = vdupq_n_u8('\\');
+	uint64_t const quote = json_bits(vceqq_u8(vin0, vq), vceqq_u8(vin1, vq), vceqq_u8(vin2, vq), vceqq_u8(vin3, vq));
+	uint64_t const backslash = json_bits(vceqq_u8(vin0, vb), vceqq_u8(vin1, vb), vceqq_u8(vin2, vb), vceqq_u8(vin3, vb));
+	uint64_t const string = json_prefix_xor(json_quotes(quote, backslash, st)) ^ st.string;
+	st.string = uint64_t(int64_t(string) >> 63);
+
+	size_t pos = sort_store04(vin0, vbicq_u8(blank_mask< set >(vin0), json_lanes(string)), output);
+	pos += sort_store04(vin1, vbicq_u8(blank_mask< set >(vin1), json_lanes(string >> 16)), output + pos);
+	pos += sort_store04(vin2, vbicq_u8(blank_mask< set >(vin2), json_lanes(string >> 32)), output + pos);
+	pos += sort_store04(vin3, vbicq_u8(blank_mask< set >(vin3), json_lanes(string >> 48)), output + pos);
+	return pos;
+}
+
+#elif __x86_64__ || __i386__
+// pclmul comes with all avx2 cores, but not with all ssse3 ones
+#define TARGET_AVX2_PCLMUL __attribute__ ((target("avx2,popcnt,pclmul")))
+
+inline bool cpu_has_avx2_pclmul() {
+	__builtin_cpu_init();
+	return cpu_has_avx2_popcnt() && __builtin_cpu_supports("pclmul");
+}
+
+// 0xff for the lanes of the set bits of a 16-bit mask
+TARGET_SSSE3 inline __m128i json_lanes(uint64_t const bits) {
+	__m128i const bit = _mm_set1_epi64x(int64_t(0x8040201008040201));
+	__m128i const v = _mm_shuffle_epi8(_mm_cvtsi32_si128(int(bits)),
+		_mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1));
+
+	return _mm_cmpeq_epi8(_mm_and_si128(v, bit), bit);
+}
+
+// minifier, 64-batch; testee04 of each 16 chars over their blanks outside strings
+template < blank_set const& set = blank_ascii >
+TARGET_SSSE3_POPCNT inline size_t json04(
+	uint8_t const* const input,
+	uint8_t* const output,
+	json_state& st) {
+
+	// all of the block is loaded before any of it is stored, for in-place
+	__m128i const vin0 = _mm_loadu_si128(reinterpret_cast< __m128i const* >(input));
+	__m128i const vin1 = _mm_loadu_si128(reinterpret_cast< __m128i const* >(input + 16));
+	__m128i const vin2 = _mm_loadu_si128(reinterpret_cast< __m128i const* >(input + 32));
+	__m128i const vin3 = _mm_loadu_si128(reinterpret_cast< __m128i const* >(input + 48));
+
+	__m128i const vq = _mm_set1_epi8('"');
+	__m128i const vb = _mm_set1_epi8('\\');
+	uint64_t const quote =
+		uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(vin0, vq)))       |
+		uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(vin1, vq))) << 16 |
+		uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(vin2, vq))) << 32 |
+		uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(vin3, vq))) << 48;
+	uint64_t const backslash =
+		uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(vin0, vb)))       |
+		uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(vin1, vb))) << 16 |
+		uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(vin2, vb))) << 32 |
+		uint64_t(_mm_movemask_epi8(_mm_cmpeq_epi8(vin3, vb))) << 48;
+	uint64_t const string = json_prefix_xor_shift(json_quotes(quote, backslash, st)) ^ st.string;
+	st.string = uint64_t(int64_t(string) >> 63);
+
+	size_t pos = sort_store04(vin0, _mm_andnot_si128(json_lanes(string), blank_mask< set >(vin0)), output);
+	pos += sort_store04(vin1, _mm_andnot_si128(json_lanes(string >> 16), blank_mask< set >(vin1)), output + pos);
+	pos += sort_store04(vin2, _mm_andnot_si128(json_lanes(string >> 32), blank_mask< set >(vin2)), output + pos);
+	pos += sort_store04(vin3, _mm_andnot_si128(json_lanes(string >> 48), blank_mask< set >(vin3)), output + pos);
+	return pos;
+}
+
+#if __x86_64__
+// prefix xor of a bitmask, by a carry-less multiply by all ones
+TARGET_AVX2_PCLMUL inline uint64_t json_prefix_xor(uint64_t const m) {
+	return _mm_cvtsi128_si64(_mm_clmulepi64_si128(_mm_cvtsi64_si128(int64_t(m)), _mm_set1_epi8(-1), 0));
+}
+
+// 0xff for the lanes of the set bits of a 32-bit mask
+TARGET_AVX2 inline __m256i json_lanes(uint32_t const bits) {
+	__m256i const bit = _mm256_set1_epi64x(int64_t(0x8040201008040201));
+	__m256i const v = _mm256_shuffle_epi8(_mm256_set1_epi32(int(bits)), _mm256_setr_epi8(
+		0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+		2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3));
+
+	return _mm256_cmpeq_epi8(_mm256_and_si256(v, bit), bit);
+}
+
+// minifier, 64-batch; testee07 of each 32 chars over their blanks outside strings
+template < blank_set const& set = blank_ascii >
+TARGET_AVX2_PCLMUL inline size_t json07(
+	uint8_t const* const input,
+	uint8_t* const output,
+	json_state& st) {
+
+	// all of the block is loaded before any of it is stored, for in-place
+	__m256i const vin0 = _mm256_loadu_si256(reinterpret_cast< __m256i const* >(input));
+	__m256i const vin1 = _mm256_loadu_si256(reinterpret_cast< __m256i const* >(input + 32));
+
+	__m256i const vq = _mm256_set1_epi8('"');
+	__m256i const vb = _mm256_set1_epi8('\\');
+	uint64_t const quote =
+		uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(vin0, vq)))) |
+		uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(vin1, vq)))) << 32;
+	uint64_t const backslash =
+		uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(vin0, vb)))) |
+		uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(vin1, vb)))) << 32;
+	uint64_t const string = json_prefix_xor(json_quotes(quote, backslash, st)) ^ st.string;
+	st.string = uint64_t(int64_t(string) >> 63);
+
+	size_t pos = sort_store07(vin0, _mm256_andnot_si256(json_lanes(uint32_t(string)), blank_mask< set >(vin0)), output);
+	pos += sort_store07(vin1, _mm256_andnot_si256(json_lanes(uint32_t(string >> 32)), blank_mask< set >(vin1)),
+		output + pos);
+	return pos;
+}
+
+#endif
+#endif
+// bulk minifying of an arbitrary-length buffer by the given minifier; returns the count of chars in out, which needs
+// no more room than len; out may equal in, for the reasons given at prune_bulk, and the tail goes to the scalar
+// minifier
+template < size_t (&minifier)(uint8_t const*, uint8_t*, json_state&), blank_set const& set >
+__attribute__ ((always_inline)) inline size_t json_bulk(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	json_state& st) {
+
+	size_t i = 0, pos = 0;
+
+	for (; i + 64 <= len; i += 64)
+		pos += minifier(in + i, out + pos, st);
+
+	return pos + json_chars< set >(in + i, len - i, out + pos, st);
+}
+
+// bulk minifier entry points; these carry the isa of their minifier so the latter inlines
+typedef size_t (*json_fn)(uint8_t const* in, size_t len, uint8_t* out, json_state& st);
+
+template < blank_set const& set = blank_ascii >
+inline size_t json_testee00(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	json_state& st) {
+
+	return json_chars< set >(in, len, out, st);
+}
+
+#if __aarch64__
+template < blank_set const& set = blank_ascii >
+inline size_t json_testee04(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	json_state& st) {
+
+	return json_bulk< json04< set >, set >(in, len, out, st);
+}
+
+#elif __x86_64__ || __i386__
+template < blank_set const& set = blank_ascii >
+TARGET_SSSE3_POPCNT inline size_t json_testee04(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	json_state& st) {
+
+	return json_bulk< json04< set >, set >(in, len, out, st);
+}
+
+#if __x86_64__
+template < blank_set const& set = blank_ascii >
+TARGET_AVX2_PCLMUL inline size_t json_testee07(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	json_state& st) {
+
+	return json_bulk< json07< set >, set >(in, len, out, st);
+}
+
+#endif
+#endif
+// pick the best minifier for the cpu we run on
+template < blank_set const& set = blank_ascii >
+inline json_fn select_minifier() {
+	static_assert(!set.utf8, "utf-8 sets not supported by minifiers");
+
+#if __aarch64__
+	return json_testee04< set >;
+
+#elif __x86_64__
+	return cpu_has_avx2_pclmul() ? json_testee07< set > :
+		cpu_has_ssse3_popcnt() ? json_testee04< set > : json_testee00< set >;
+
+#elif __i386__
+	return cpu_has_ssse3_popcnt() ? json_testee04< set > : json_testee00< set >;
+
+#else
+	return json_testee00< set >;
+
+#endif
+}
+
+// minify the next piece of a json stream, by the best minifier for the cpu; returns the count of chars in out, which
+// needs no more room than len; out may equal in. Pieces may split the stream anywhere; st carries whether the split
+// falls in a string, or after an escaping backslash
+template < blank_set const& set = blank_ascii >
+inline size_t json_feed(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	json_state& st) {
+
+	static json_fn const fn = select_minifier< set >();
+	return fn(in, len, out, st);
+}
+
+// minify a json document of arbitrary length; returns the count of chars in out, which needs no more room than len;
+// out may equal in
+template < blank_set const& set = blank_ascii >
+inline size_t json_minify(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out) {
+
+	json_state st = json_init();
+	return json_feed< set >(in, len, out, st);
+}
+
+#endif // PRUNE_JSON_H_
@@ -0,0 +1,230 @@
+// pruning of blanks from an ascii stream -- pruning with a map back to the source
+#ifndef PRUNE_MAP_H_
+#define PRUNE_MAP_H_
+
+#include "prune.h"
+
+// Alongside the pruned chars, write the offset in the input of each, as a uint32_t, so that an error reported at some
+// offset of the pruned text can be traced back to the original char. The index that testee04 samples its batch by is
+// exactly the source lane of each output char, so the map is that index, widened and offset by the batch's position,
+// and stored along with the chars, in the same pass and by the same store pattern.
+
+// scalar pruner with map, 16-batch
+template < blank_set const& set = blank_space >
+inline size_t map00(
+	uint8_t const* const input,
+	uint8_t* const output,
+	uint32_t* const map,
+	uint32_t const offset) {
+
+	size_t pos = 0;
+	for (size_t i = 0; i < 16; ++i) {
+		uint8_t const c = input[i];
+		output[pos] = c;
+		map[pos] = offset + uint32_t(i);
+		pos += is_blank< set >(c) ? 0 : 1;
+	}
+	return pos;
+}
+
+#if __aarch64__
+// pruner with map, 16-batch; testee04 plus its index, widened to 32 bits
+template < blank_set const& set = blank_space >
+inline size_t map04(
+	uint8_t const* const input,
+	uint8_t* const output,
+	uint32_t* const map,
+	uint32_t const offset) {
+
+	uint8x16_t const vin = vld1q_u8(input);
+	uint8x16_t const bmask = blank_mask< set >(vin);
+
+	uint8x16_t const risen = vorrq_u8(bmask, (uint8x16_t) { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 });
+	uint8x16_t const index = sort_index04(risen);
+
+	uint8x16_t const res = vqtbl1q_u8(vin, index);
+	vst1q_u8(output, res);
+
+	// the lanes of blanks, past the non-blanks, widen to junk that the next batch overwrites
+	uint32x4_t const base = vdupq_n_u32(offset);
+	uint16x8_t const index_lo = vmovl_u8(vget_low_u8(index));
+	uint16x8_t const index_hi = vmovl_high_u8(index);
+
+	vst1q_u32(map +  0, vaddw_u16(base, vget_low_u16(index_lo)));
+	vst1q_u32(map +  4, vaddw_high_u16(base, index_lo));
+	vst1q_u32(map +  8, vaddw_u16(base, vget_low_u16(index_hi)));
+	vst1q_u32(map + 12, vaddw_high_u16(base, index_hi));
+	return sizeof(uint8x16_t) + int8_t(vaddvq_u8(bmask));
+}
+
+#elif __x86_64__ || __i386__
+// pruner with map, 16-batch; testee04 plus its index, widened to 32 bits
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t map04(
+	uint8_t const* const input,
+	uint8_t* const output,
+	uint32_t* const map,
+	uint32_t const offset) {
+
+	__m128i const vin = _mm_loadu_si128(reinterpret_cast< __m128i const* >(input));
+	__m128i const bmask = blank_mask< set >(vin);
+
+	__m128i const risen = _mm_or_si128(bmask, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15));
+	__m128i const index = sort_index04(risen);
+
+	// widen each 4-lane cluster of the index to 32 bits; the lanes of blanks, past the cluster's non-blanks, widen to
+	// junk that the next cluster overwrites
+	__m128i const base = _mm_set1_epi32(offset);
+	__m128i const map0 = _mm_add_epi32(base, _mm_shuffle_epi8(index, _mm_setr_epi8( 0, -1, -1, -1,  1, -1, -1, -1,  2, -1, -1, -1,  3, -1, -1, -1)));
+	__m128i const map1 = _mm_add_epi32(base, _mm_shuffle_epi8(index, _mm_setr_epi8( 4, -1, -1, -1,  5, -1, -1, -1,  6, -1, -1, -1,  7, -1, -1, -1)));
+	__m128i const map2 = _mm_add_epi32(base, _mm_shuffle_epi8(index, _mm_setr_epi8( 8, -1, -1, -1,  9, -1, -1, -1, 10, -1, -1, -1, 11, -1, -1, -1)));
+	__m128i const map3 = _mm_add_epi32(base, _mm_shuffle_epi8(index, _mm_setr_epi8(12, -1, -1, -1, 13, -1, -1, -1, 14, -1, -1, -1, 15, -1, -1, -1)));
+
+	uint32_t const bitmask = ~_mm_movemask_epi8(bmask);
+	pieces04 const p = pieces_of04(bitmask);
+	store_pieces04(_mm_shuffle_epi8(vin, index), p, output);
+
+	_mm_storeu_si128(reinterpret_cast< __m128i* >(map),          map0);
+	_mm_storeu_si128(reinterpret_cast< __m128i* >(map + p.len0), map1);
+	_mm_storeu_si128(reinterpret_cast< __m128i* >(map + p.len1), map2);
+	_mm_storeu_si128(reinterpret_cast< __m128i* >(map + p.len2), map3);
+	return _mm_popcnt_u32(bitmask & 0xffff);
+}
+
+#endif
+// bulk pruning with map of an arbitrary-length buffer by the given pruner; returns the count of non-blanks in out and
+// of offsets in map, which need no more room than len; offsets are 32-bit, so len must be below 4GB -- prune longer
+// input piecewise and add each piece's position to its offsets. As with prune_bulk, out may equal in, batches that
+// could store past len go off-line, and utf-8 sets are canonicalized first, which keeps the offsets, as a unicode space
+// canonicalizes in place
+template < size_t batch, size_t (&mapper)(uint8_t const*, uint8_t*, uint32_t*, uint32_t), blank_set const& set >
+__attribute__ ((always_inline)) inline size_t prune_map_bulk(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	uint32_t* const map) {
+
+	uint8_t tmp_in[batch] __attribute__ ((aligned(64)));
+	uint8_t tmp_out[batch] __attribute__ ((aligned(64)));
+	uint32_t tmp_map[batch] __attribute__ ((aligned(64)));
+
+	if (set.utf8) {
+		utf8_state st = utf8_init();
+		size_t pos = 0;
+
+		for (size_t i = 0; i < len; i += batch) {
+			size_t const n = len - i < batch ? len - i : batch;
+			utf8_canon< batch, set >(in + i, n, len - i, tmp_in, st);
+
+			bool const direct = pos + batch <= len;
+			size_t const kept = mapper(tmp_in, direct ? out + pos : tmp_out, direct ? map + pos : tmp_map, uint32_t(i)) -
+				(set.empty ? batch - n : 0);
+
+			if (!direct) {
+				memcpy(out + pos, tmp_out, kept);
+				memcpy(map + pos, tmp_map, kept * sizeof(tmp_map[0]));
+			}
+			pos += kept;
+		}
+		return pos;
+	}
+
+	size_t i = 0, pos = 0;
+	for (; i + batch <= len && pos + batch <= len; i += batch)
+		pos += mapper(in + i, out + pos, map + pos, uint32_t(i));
+
+	for (; i + batch <= len; i += batch) {
+		size_t const kept = mapper(in + i, tmp_out, tmp_map, uint32_t(i));
+		memcpy(out + pos, tmp_out, kept);
+		memcpy(map + pos, tmp_map, kept * sizeof(tmp_map[0]));
+		pos += kept;
+	}
+
+	// the tail goes padded with blanks, as at prune_bulk
+	if (i < len) {
+		memset(tmp_in, set.pad, sizeof(tmp_in));
+		memcpy(tmp_in, in + i, len - i);
+
+		size_t const kept = mapper(tmp_in, tmp_out, tmp_map, uint32_t(i)) - (set.empty ? batch - (len - i) : 0);
+		memcpy(out + pos, tmp_out, kept);
+		memcpy(map + pos, tmp_map, kept * sizeof(tmp_map[0]));
+		pos += kept;
+	}
+	return pos;
+}
+
+// bulk entry points; these carry the isa of their pruner so the latter inlines
+typedef size_t (*prune_map_fn)(uint8_t const* in, size_t len, uint8_t* out, uint32_t* map);
+
+template < blank_set const& set = blank_space >
+inline size_t prune_map00(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	uint32_t* const map) {
+
+	return prune_map_bulk< 16, map00< set >, set >(in, len, out, map);
+}
+
+#if __aarch64__
+template < blank_set const& set = blank_space >
+inline size_t prune_map04(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	uint32_t* const map) {
+
+	return prune_map_bulk< 16, map04< set >, set >(in, len, out, map);
+}
+
+#elif __x86_64__ || __i386__
+template < blank_set const& set = blank_space >
+TARGET_SSSE3_POPCNT inline size_t prune_map04(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	uint32_t* const map) {
+
+	return prune_map_bulk< 16, map04< set >, set >(in, len, out, map);
+}
+
+#endif
+// pick the best pruner with map for the cpu we run on
+template < blank_set const& set = blank_space >
+inline prune_map_fn select_map_pruner() {
+#if __aarch64__
+	return prune_map04< set >;
+
+#elif __x86_64__ || __i386__
+	return cpu_has_ssse3_popcnt() ? prune_map04< set > : prune_map00< set >;
+
+#else
+	return prune_map00< set >;
+
+#endif
+}
+
+// prune blanks from a buffer below 4GB, writing the input offset of each non-blank kept to map; returns the count of
+// non-blanks in out, and of offsets in map; out may equal in
+template < blank_set const& set = blank_space >
+inline size_t prune_map(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	uint32_t* const map) {
+
+	static prune_map_fn const fn = select_map_pruner< set >();
+#if PRUNE_STATS
+	prune_stats_record& st = prune_stats_self();
+	bool const sample = prune_stats_begin(st, len);
+	size_t const kept = fn(in, len, out, map);
+	prune_stats_end(st, len, kept, sample);
+	return kept;
+
+#else
+	return fn(in, len, out, map);
+
+#endif
+}
+
+#endif // PRUNE_MAP_H_
@@ -0,0 +1,248 @@
+// pruning of blanks from an ascii stream -- multi-threaded bulk pruning
+#ifndef PRUNE_MT_H_
+#define PRUNE_MT_H_
+
+#include "prune.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+enum {
+	prune_mt_max_threads = 256,
+	prune_mt_min_chunk = 1 << 16, // below that a thread does not pay off
+	prune_mt_align = 128,         // chunk granularity; a multiple of all batch sizes, and of a cache line
+	prune_mt_tile = 1 << 16       // look-back tile; the pruned tile stays in L2 until copied out
+};
+
+struct prune_mt_job {
+	pruner const* pr;
+	uint8_t const* in;
+	size_t len;
+	uint8_t* out;
+	size_t offset; // of the chunk's non-blanks in out
+	size_t kept;   // count of the chunk's non-blanks
+};
+
+// move a chunk boundary past any utf-8 continuation chars, at most 3, so no sequence is split across chunks for the
+// utf-8 sets to miss
+inline size_t prune_mt_boundary(
+	uint8_t const* const in,
+	size_t const len,
+	size_t pos) {
+
+	if (0 == pos)
+		return 0;
+
+	for (size_t k = 0; k < 3 && pos < len && 0x80 == (in[pos] & 0xc0); ++k)
+		++pos;
+
+	return pos;
+}
+
+// pass 1: count the non-blanks of a chunk
+inline void* prune_mt_count(void* const arg) {
+	prune_mt_job& job = *reinterpret_cast< prune_mt_job* >(arg);
+	job.kept = job.pr->count(job.in, job.len);
+	return 0;
+}
+
+// pass 2: prune a chunk straight to its final place; capped at the chunk's count of non-blanks, the pruner does not
+// store into the next chunk's output
+inline void* prune_mt_prune(void* const arg) {
+	prune_mt_job& job = *reinterpret_cast< prune_mt_job* >(arg);
+	job.pr->prune(job.in, job.len, job.out + job.offset, job.kept);
+	return 0;
+}
+
+// run a pass over all jobs, job 0 on the calling thread; jobs whose thread could not be started run on the calling
+// thread as well
+inline void prune_mt_run(
+	void* (* const pass)(void*),
+	prune_mt_job* const job,
+	size_t const njobs) {
+
+	pthread_t thread[prune_mt_max_threads];
+	bool started[prune_mt_max_threads];
+
+	for (size_t i = 1; i < njobs; ++i)
+		started[i] = 0 == pthread_create(thread + i, 0, pass, job + i);
+
+	pass(job);
+
+	for (size_t i = 1; i < njobs; ++i)
+		if (started[i])
+			pthread_join(thread[i], 0);
+		else
+			pass(job + i);
+}
+
+// prune blanks from an arbitrary-length buffer across up to nthreads threads, in two passes over per-thread chunks:
+// the first counts the non-blanks of each chunk, an exclusive prefix sum of those gives each chunk's offset in out,
+// and the second prunes each chunk straight to that offset; same output as a single bulk call of the same pruner,
+// by default the one prune() uses; returns the count of non-blanks in out; out must not overlap in, as a chunk's
+// output can land on the input of its predecessor while that is still being read -- see prune_lookback for in-place
+// pruning
+inline size_t prune_parallel(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const nthreads,
+	pruner const* pr = 0) {
+
+	if (0 == pr)
+		pr = select_pruner();
+
+	size_t const max_jobs = nthreads < size_t(prune_mt_max_threads) ? nthreads : size_t(prune_mt_max_threads);
+	size_t const by_size = len / prune_mt_min_chunk;
+	size_t const want = by_size < max_jobs ? by_size : max_jobs;
+
+	if (want < 2)
+		return pr->prune(in, len, out, len);
+
+	size_t const chunk = ((len + want - 1) / want + prune_mt_align - 1) & ~size_t(prune_mt_align - 1);
+
+	prune_mt_job job[prune_mt_max_threads];
+	size_t njobs = 0;
+
+	for (size_t start = 0; start < len; start += chunk, ++njobs) {
+		size_t const first = prune_mt_boundary(in, len, start);
+		size_t const last = len - start < chunk ? len : prune_mt_boundary(in, len, start + chunk);
+
+		job[njobs].pr = pr;
+		job[njobs].in = in + first;
+		job[njobs].len = last - first;
+		job[njobs].out = out;
+	}
+
+	prune_mt_run(prune_mt_count, job, njobs);
+
+	size_t offset = 0;
+	for (size_t i = 0; i < njobs; ++i) {
+		job[i].offset = offset;
+		offset += job[i].kept;
+	}
+
+	prune_mt_run(prune_mt_prune, job, njobs);
+	return offset;
+}
+
+// single-pass alternative to the above, after the decoupled look-back of gpu stream compaction: workers claim tiles
+// off an atomic counter, prune each into a private buffer -- the pruner's return, the sum of its per-batch lengths,
+// being the tile's count of non-blanks -- and publish that count; the tile's offset in out is then resolved by
+// walking back over the predecessors' published counts until one that has published its inclusive prefix, and the
+// tile is copied out. The input is read once, from memory, while the pruned tile is copied out of cache.
+
+// tile status word: the count in the upper bits, the state in the lower two
+enum {
+	prune_lb_pending = 0,   // nothing published yet
+	prune_lb_aggregate = 1, // count of the tile's own non-blanks
+	prune_lb_prefix = 2     // count of the non-blanks of this and all preceding tiles
+};
+
+struct prune_lb_ctx {
+	pruner const* pr;
+	uint8_t const* in;
+	size_t len;
+	uint8_t* out;
+	size_t ntiles;
+	size_t next;      // next tile to claim
+	uint64_t* status; // ntiles-sized
+};
+
+inline void prune_lb_relax(size_t const spin) {
+	// a preempted predecessor is better waited on from the scheduler
+	if (0 == (spin + 1) % 64) {
+		sched_yield();
+		return;
+	}
+
+#if __aarch64__
+	asm volatile ("yield" : : : "memory");
+
+#elif __x86_64__ || __i386__
+	__builtin_ia32_pause();
+
+#endif
+}
+
+inline void* prune_lb_work(void* const arg) {
+	prune_lb_ctx& ctx = *reinterpret_cast< prune_lb_ctx* >(arg);
+	uint8_t tile[prune_mt_tile + prune_mt_align] __attribute__ ((aligned(prune_mt_align)));
+
+	for (;;) {
+		size_t const t = __atomic_fetch_add(&ctx.next, 1, __ATOMIC_RELAXED);
+		if (t >= ctx.ntiles)
+			break;
+
+		size_t const start = prune_mt_boundary(ctx.in, ctx.len, t * prune_mt_tile);
+		size_t const end = t + 1 < ctx.ntiles ? prune_mt_boundary(ctx.in, ctx.len, (t + 1) * prune_mt_tile) : ctx.len;
+		size_t const kept = ctx.pr->prune(ctx.in + start, end - start, tile, end - start);
+
+		// tiles are claimed in order, so all predecessors are claimed by running workers and the look-back ends
+		size_t prefix = 0;
+		if (0 != t) {
+			__atomic_store_n(ctx.status + t, uint64_t(kept) << 2 | prune_lb_aggregate, __ATOMIC_RELEASE);
+
+			for (size_t p = t; p-- > 0; ) {
+				uint64_t s;
+				for (size_t spin = 0; prune_lb_pending == ((s = __atomic_load_n(ctx.status + p, __ATOMIC_ACQUIRE)) & 3); ++spin)
+					prune_lb_relax(spin);
+
+				prefix += size_t(s >> 2);
+				if (prune_lb_prefix == (s & 3))
+					break;
+			}
+		}
+
+		__atomic_store_n(ctx.status + t, uint64_t(prefix + kept) << 2 | prune_lb_prefix, __ATOMIC_RELEASE);
+		memcpy(ctx.out + prefix, tile, kept);
+	}
+
+	return 0;
+}
+
+// prune blanks from an arbitrary-length buffer across up to nthreads threads, in a single pass by decoupled
+// look-back; same output as prune_parallel; returns the count of non-blanks in out; out may equal in, as a tile is
+// copied out only once all tiles before it have published, i.e. are done reading, and its output ends at or before
+// its input does, where the reads of later tiles start
+inline size_t prune_lookback(
+	uint8_t const* const in,
+	size_t const len,
+	uint8_t* const out,
+	size_t const nthreads,
+	pruner const* pr = 0) {
+
+	if (0 == pr)
+		pr = select_pruner();
+
+	size_t const ntiles = (len + prune_mt_tile - 1) / prune_mt_tile;
+	size_t const nworkers = nthreads < size_t(prune_mt_max_threads) ? nthreads : size_t(prune_mt_max_threads);
+
+	if (nworkers < 2 || ntiles < 2)
+		return pr->prune(in, len, out, len);
+
+	uint64_t* const status = reinterpret_cast< uint64_t* >(calloc(ntiles, sizeof(uint64_t)));
+	if (0 == status)
+		return prune_parallel(in, len, out, nthreads, pr);
+
+	prune_lb_ctx ctx = { pr, in, len, out, ntiles, 0, status };
+
+	// workers that could not be started leave their share to the rest
+	pthread_t thread[prune_mt_max_threads];
+	bool started[prune_mt_max_threads];
+
+	for (size_t i = 1; i < nworkers; ++i)
+		started[i] = 0 == pthread_create(thread + i, 0, prune_lb_work, &ctx);
+
+	prune_lb_work(&ctx);
+
+	for (size_t i = 1; i < nworkers; ++i)
+		if (started[i])
+			pthread_join(thread[i], 0);
+
+	size_t const total = size_t(status[ntiles - 1] >> 2);
+	free(status);
+	return total;
+}
+
+#endif // PRUNE_MT_H_
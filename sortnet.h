@@ -0,0 +1,355 @@
+// pruning of blanks from an ascii stream -- sorting networks, compiled into vector shuffle and min/max stages
+#ifndef SORTNET_H_
+#define SORTNET_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// A comparator network is given as a list of comparators, stage by stage, e.g.
+//
+//   constexpr int my_list[] = { 0, 1, 2, 3, sortnet_next, 0, 2, 1, 3, sortnet_next, 1, 2 };
+//   constexpr sortnet my_net = sortnet_of(4, 4, my_list);
+//
+// sortnet_plan_of() then compiles it for a vector form, the way the hand-written testee04/05 do: each stage gathers
+// the lesser wire of every comparator into one vector and the greater into another, by a shuffle of the previous
+// stage's min and max vectors, and takes the min and max of the two. A stage needs only as many lanes as it has
+// comparators, but all wires have to pass through it; the wires left out of the stage are paired among themselves,
+// each pair known to be in order already -- 'frozen' -- so their min/max is a no-op that keeps them in deterministic
+// lanes. The known order is derived from the comparators so far. Wires for which no such partner is left pass through
+// paired with themselves, where the form has the lanes to spare. The last stage's lanes are then gathered in wire
+// order, which is the sorted index.
+
+enum {
+	sortnet_max_wires = 32,
+	sortnet_max_stages = 32,
+	sortnet_max_pairs = 16,
+
+	sortnet_next = -1 // stage separator in comparator lists
+};
+
+// comparator network; each comparator takes the min of its two wires to the lower one
+struct sortnet {
+	uint8_t wires;
+	uint8_t run;    // count of wires per run the network sorts, e.g. 4 for four independent 4-sorters
+	uint8_t stages;
+	uint8_t count[sortnet_max_stages]; // comparators per stage
+	uint8_t pair[sortnet_max_stages][sortnet_max_pairs][2];
+};
+
+// network of the given comparator list, stages separated by sortnet_next
+template < size_t N >
+constexpr sortnet sortnet_of(
+	unsigned const wires,
+	unsigned const run,
+	int const (&list)[N]) {
+
+	sortnet net = {};
+	net.wires = uint8_t(wires);
+	net.run = uint8_t(run);
+	net.stages = 1;
+
+	for (size_t i = 0; i < N; ) {
+		if (sortnet_next == list[i]) {
+			++net.stages;
+			++i;
+			continue;
+		}
+		uint8_t const s = net.stages - 1;
+		uint8_t const lo = uint8_t(list[i] < list[i + 1] ? list[i] : list[i + 1]);
+		uint8_t const hi = uint8_t(list[i] < list[i + 1] ? list[i + 1] : list[i]);
+		net.pair[s][net.count[s]][0] = lo;
+		net.pair[s][net.count[s]][1] = hi;
+		++net.count[s];
+		i += 2;
+	}
+	return net;
+}
+
+// Batcher's odd-even merge sort of any count of wires, a stage per merge step
+constexpr sortnet sortnet_batcher(unsigned const wires) {
+	sortnet net = {};
+	net.wires = uint8_t(wires);
+	net.run = uint8_t(wires);
+
+	for (unsigned p = 1; p < wires; p <<= 1)
+		for (unsigned k = p; k >= 1; k >>= 1) {
+			uint8_t const s = net.stages++;
+
+			for (unsigned j = k % p; j + k < wires; j += 2 * k)
+				for (unsigned i = 0; i < k && i + j + k < wires; ++i)
+					if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+						net.pair[s][net.count[s]][0] = uint8_t(i + j);
+						net.pair[s][net.count[s]][1] = uint8_t(i + j + k);
+						++net.count[s];
+					}
+		}
+	return net;
+}
+
+// 16-element sorting network: http://pages.ripco.net/~jgamble/nw.html -- 'Best version'; that of testee04/arm64
+constexpr int sortnet_best16_list[] = {
+	0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15, sortnet_next,
+	0,  2,  4,  6,  8, 10, 12, 14,  1,  3,  5,  7,  9, 11, 13, 15, sortnet_next,
+	0,  4,  8, 12,  1,  5,  9, 13,  2,  6, 10, 14,  3,  7, 11, 15, sortnet_next,
+	0,  8,  1,  9,  2, 10,  3, 11,  4, 12,  5, 13,  6, 14,  7, 15, sortnet_next,
+	5, 10,  6,  9,  3, 12, 13, 14,  7, 11,  1,  2,  4,  8,         sortnet_next,
+	1,  4,  7, 13,  2,  8, 11, 14,  5,  6,  9, 10,                 sortnet_next,
+	2,  4, 11, 13,  3,  8,  7, 12,                                 sortnet_next,
+	6,  8, 10, 12,  3,  5,  7,  9,                                 sortnet_next,
+	3,  4,  5,  6,  7,  8,  9, 10, 11, 12,                         sortnet_next,
+	6,  7,  8,  9
+};
+
+// four 4-element sorting networks side by side; that of testee04/amd64
+constexpr int sortnet_quad16_list[] = {
+	0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15, sortnet_next,
+	0,  2,  1,  3,  4,  6,  5,  7,  8, 10,  9, 11, 12, 14, 13, 15, sortnet_next,
+	1,  2,  5,  6,  9, 10, 13, 14
+};
+
+constexpr sortnet sortnet_best16 = sortnet_of(16, 16, sortnet_best16_list);
+constexpr sortnet sortnet_quad16 = sortnet_of(16, 4, sortnet_quad16_list);
+
+// vector forms a plan can be compiled for, by the lanes of their min and max vectors
+enum {
+	sortnet_form_ssse3 = 8, // 128-bit regs, the low halves of min and max unpacked into one table for the next pshufb
+	sortnet_form_d = 8,     // arm64 64-bit regs, min and max as a two-register table
+	sortnet_form_q = 16     // arm64 128-bit regs, ditto
+};
+
+// sources a stage's shuffle can take its lanes from
+enum {
+	sortnet_src_input, // the risen index -- first stage only
+	sortnet_src_min,   // the previous min vector alone
+	sortnet_src_max,   // the previous max vector alone
+	sortnet_src_both,  // both
+	sortnet_src_as_is  // the previous min vector, unshuffled
+};
+
+// a network compiled for a vector form: per stage, the lanes of the shuffles that gather the lesser and the greater
+// wire of each comparator, out of the previous stage's min vector, at lane k < half, and max vector, at half + k --
+// or out of just one of those, at lane k, as src_a and src_b say
+struct sortnet_plan {
+	bool ok;      // false if some stage needs more lanes than the form has
+	uint8_t wires;
+	uint8_t run;
+	uint8_t half; // lanes per min or max vector
+	uint8_t stages;
+	uint8_t src_a[sortnet_max_stages]; // sortnet_src_*
+	uint8_t src_b[sortnet_max_stages];
+	alignas(16) uint8_t a[sortnet_max_stages][sortnet_max_pairs];
+	alignas(16) uint8_t b[sortnet_max_stages][sortnet_max_pairs];
+	alignas(16) uint8_t index[sortnet_max_wires]; // lane of each wire after the last stage
+};
+
+struct sortnet_order {
+	bool le[sortnet_max_wires][sortnet_max_wires]; // wire i is known to be at most wire j
+};
+
+// known order after a comparator: lo takes the min of the two, hi the max
+constexpr void sortnet_order_apply(
+	sortnet_order& ord,
+	unsigned const wires,
+	unsigned const lo,
+	unsigned const hi) {
+
+	sortnet_order const o = ord;
+	for (unsigned k = 0; k < wires; ++k) {
+		if (k == lo || k == hi)
+			continue;
+
+		ord.le[k][lo] = o.le[k][lo] && o.le[k][hi];
+		ord.le[lo][k] = o.le[lo][k] || o.le[hi][k];
+		ord.le[k][hi] = o.le[k][lo] || o.le[k][hi];
+		ord.le[hi][k] = o.le[lo][k] && o.le[hi][k];
+	}
+	ord.le[lo][hi] = true;
+	ord.le[hi][lo] = o.le[lo][hi] && o.le[hi][lo];
+}
+
+constexpr void sortnet_order_close(
+	sortnet_order& ord,
+	unsigned const wires) {
+
+	for (unsigned m = 0; m < wires; ++m)
+		for (unsigned i = 0; i < wires; ++i)
+			if (ord.le[i][m])
+				for (unsigned j = 0; j < wires; ++j)
+					ord.le[i][j] = ord.le[i][j] || ord.le[m][j];
+}
+
+// search state of sortnet_match
+struct sortnet_matching {
+	uint8_t pair[sortnet_max_pairs][2];
+	unsigned count;
+};
+
+// pair up the idle wires from the first unused one on, each pair known to be in order; keeps the best found in best
+constexpr void sortnet_match_from(
+	sortnet_order const& ord,
+	uint8_t const (&idle)[sortnet_max_wires],
+	unsigned const n,
+	uint32_t const used,
+	sortnet_matching& cur,
+	sortnet_matching& best) {
+
+	unsigned first = 0;
+	while (first < n && used >> first & 1)
+		++first;
+
+	unsigned left = 0;
+	for (unsigned i = first; i < n; ++i)
+		left += used >> i & 1 ? 0 : 1;
+
+	if (cur.count + left / 2 <= best.count)
+		return;
+
+	if (cur.count > best.count)
+		best = cur;
+
+	if (first == n)
+		return;
+
+	uint8_t const u = idle[first];
+	for (unsigned c = first + 1; c < n; ++c) {
+		uint8_t const v = idle[c];
+		if (used >> c & 1 || !(ord.le[u][v] || ord.le[v][u]))
+			continue;
+
+		cur.pair[cur.count][0] = ord.le[u][v] ? u : v;
+		cur.pair[cur.count][1] = ord.le[u][v] ? v : u;
+		++cur.count;
+		sortnet_match_from(ord, idle, n, used | 1u << first | 1u << c, cur, best);
+		--cur.count;
+	}
+
+	// or leave the first one unpaired
+	sortnet_match_from(ord, idle, n, used | 1u << first, cur, best);
+}
+
+// pair up as many of the n wires in idle as possible, each pair known to be in order, lesser wire first
+constexpr sortnet_matching sortnet_match(
+	sortnet_order const& ord,
+	uint8_t const (&idle)[sortnet_max_wires],
+	unsigned const n) {
+
+	sortnet_matching cur = {}, best = {};
+	sortnet_match_from(ord, idle, n, 0, cur, best);
+	return best;
+}
+
+// compile a network for the vector form of the given lanes per min or max vector
+constexpr sortnet_plan sortnet_plan_of(
+	sortnet const& net,
+	unsigned const half) {
+
+	sortnet_plan plan = {};
+	plan.ok = true;
+	plan.wires = net.wires;
+	plan.run = net.run;
+	plan.half = uint8_t(half);
+	plan.stages = net.stages;
+
+	sortnet_order ord = {};
+	for (unsigned i = 0; i < net.wires; ++i)
+		ord.le[i][i] = true;
+
+	// lane of each wire: the risen index before the first stage
+	uint8_t lane[sortnet_max_wires] = {};
+	for (unsigned i = 0; i < net.wires; ++i)
+		lane[i] = uint8_t(i);
+
+	for (unsigned s = 0; s < net.stages; ++s) {
+		uint8_t pair[sortnet_max_pairs * 2][2] = {};
+		unsigned npairs = net.count[s];
+
+		bool busy[sortnet_max_wires] = {};
+		for (unsigned k = 0; k < npairs; ++k) {
+			pair[k][0] = net.pair[s][k][0];
+			pair[k][1] = net.pair[s][k][1];
+			busy[pair[k][0]] = busy[pair[k][1]] = true;
+		}
+
+		// pair up the idle wires in known order; the rest pass with themselves
+		uint8_t idle[sortnet_max_wires] = {};
+		unsigned nidle = 0;
+		for (unsigned i = 0; i < net.wires; ++i)
+			if (!busy[i])
+				idle[nidle++] = uint8_t(i);
+
+		sortnet_matching const frozen = sortnet_match(ord, idle, nidle);
+		for (unsigned k = 0; k < frozen.count; ++k) {
+			pair[npairs][0] = frozen.pair[k][0];
+			pair[npairs][1] = frozen.pair[k][1];
+			busy[frozen.pair[k][0]] = busy[frozen.pair[k][1]] = true;
+			++npairs;
+		}
+		for (unsigned i = 0; i < net.wires; ++i)
+			if (!busy[i]) {
+				pair[npairs][0] = pair[npairs][1] = uint8_t(i);
+				++npairs;
+			}
+
+		if (npairs > half) {
+			plan.ok = false;
+			return plan;
+		}
+
+		// in the order of the lesser wires' lanes, which leaves the min vector as is where it holds all of those
+		for (unsigned k = 1; 0 != s && k < npairs; ++k)
+			for (unsigned j = k; j > 0 && lane[pair[j][0]] < lane[pair[j - 1][0]]; --j) {
+				uint8_t const lo = pair[j][0], hi = pair[j][1];
+				pair[j][0] = pair[j - 1][0];
+				pair[j][1] = pair[j - 1][1];
+				pair[j - 1][0] = lo;
+				pair[j - 1][1] = hi;
+			}
+
+		for (unsigned k = 0; k < npairs; ++k) {
+			plan.a[s][k] = lane[pair[k][0]];
+			plan.b[s][k] = lane[pair[k][1]];
+		}
+
+		// a shuffle of just the min or just the max vector saves the unpack of the two on ssse3, and takes a shorter
+		// table on arm64
+		{
+			plan.src_a[s] = plan.src_b[s] = 0 == s ? uint8_t(sortnet_src_input) : uint8_t(sortnet_src_both);
+			for (unsigned v = 0; v < 2 && 0 != s; ++v) {
+				uint8_t (&idx)[sortnet_max_pairs] = v ? plan.b[s] : plan.a[s];
+				bool all_min = true, all_max = true, as_is = true;
+				for (unsigned k = 0; k < npairs; ++k) {
+					all_min = all_min && idx[k] < half;
+					all_max = all_max && idx[k] >= half;
+					as_is = as_is && idx[k] == k;
+				}
+
+				uint8_t const src = as_is ? sortnet_src_as_is : all_min ? sortnet_src_min : all_max ? sortnet_src_max : sortnet_src_both;
+				(v ? plan.src_b[s] : plan.src_a[s]) = src;
+
+				if (sortnet_src_max == src)
+					for (unsigned k = 0; k < npairs; ++k)
+						idx[k] -= uint8_t(half);
+			}
+		}
+
+		for (unsigned k = 0; k < npairs; ++k) {
+			lane[pair[k][1]] = uint8_t(half + k);
+			lane[pair[k][0]] = uint8_t(k);
+		}
+
+		// unused lanes sample whatever; keep them in range
+		for (unsigned k = npairs; k < half; ++k)
+			plan.a[s][k] = plan.b[s][k] = 0;
+
+		for (unsigned k = 0; k < net.count[s]; ++k)
+			sortnet_order_apply(ord, net.wires, net.pair[s][k][0], net.pair[s][k][1]);
+		sortnet_order_close(ord, net.wires);
+	}
+
+	for (unsigned i = 0; i < net.wires; ++i)
+		plan.index[i] = lane[i];
+
+	return plan;
+}
+
+#endif // SORTNET_H_
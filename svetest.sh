@@ -0,0 +1,66 @@
+#!/bin/bash
+# check the sve pruners against the scalar one under qemu-user, at all sve vector lengths: the 32 chars of prune.cpp,
+# then bench's check of kept count and kept chars over every length from 1 to three vectors and one char past
+
+if [ -z `which qemu-aarch64` ]; then
+	echo "error: qemu-aarch64 not found"
+	exit 255
+fi
+
+if [ -z $CC ]; then
+	CC=aarch64-linux-gnu-g++
+fi
+if [ -z `which $CC` ]; then
+	echo "error: $CC not found; envvar CC must hold the path to aarch64 compiler"
+	exit 253
+fi
+
+CFLAGS=(
+	-O3
+	-fno-rtti
+	-fno-exceptions
+	-fstrict-aliasing
+	-march=armv8.2-a+sve
+	-static
+)
+
+${CC} ${CFLAGS[@]} prune.cpp -o prune_sve || exit 252
+${CC} ${CFLAGS[@]} bench.cpp -o bench_sve -pthread || exit 252
+
+# sve-default-vector-length is in bytes
+REF=$(qemu-aarch64 -cpu max ./prune_sve testee00 1 2>&1 | sed "s/^[^:]\+: //")
+FAIL=0
+
+for VL in 16 32 64 128 256; do
+	TESTEES=(testee10)
+	if [[ ${VL} -eq 64 ]]; then
+		TESTEES+=(testee08)
+	fi
+	for TESTEE in ${TESTEES[@]}; do
+		OUT=$(qemu-aarch64 -cpu max,sve-default-vector-length=${VL} ./prune_sve ${TESTEE} 1 2>&1 | sed "s/^[^:]\+: //")
+		if [[ "${OUT}" == "${REF}" ]]; then
+			echo "vl ${VL}: ${TESTEE} ok"
+		else
+			echo "vl ${VL}: ${TESTEE} mismatch: ${OUT}"
+			FAIL=1
+		fi
+
+		# -n 0 picks bench's default size, so the empty input is left to the guard of the pruner's loop
+		BAD=
+		for ((LEN = 1; LEN <= 3 * VL + 1; ++LEN)); do
+			ROW=$(qemu-aarch64 -cpu max,sve-default-vector-length=${VL} ./bench_sve -n ${LEN} -p 1 -r 1 -w 0 \
+				-i density -d 25 -l 2 ${TESTEE} 2>/dev/null | grep "^| ${TESTEE} ")
+			if [ -z "${ROW}" ] || [[ "${ROW}" == *mismatch* ]]; then
+				BAD="${BAD} ${LEN}"
+			fi
+		done
+		if [ -z "${BAD}" ]; then
+			echo "vl ${VL}: ${TESTEE} ok at lengths 1 to $((3 * VL + 1))"
+		else
+			echo "vl ${VL}: ${TESTEE} mismatch at lengths${BAD}"
+			FAIL=1
+		fi
+	done
+done
+
+exit ${FAIL}